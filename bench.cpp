@@ -0,0 +1,473 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <variant>
+#endif
+#include "primitive.hpp"
+#include "invariant_divisor.hpp"
+#include "endian_primitive.hpp"
+#include "scan.hpp"
+#include "wide_primitive.hpp"
+#include "half.hpp"
+#include "dynamic_primitive_column.hpp"
+#include "bit.hpp"
+#include "primitive_counter.hpp"
+#include "sparse_primitive_array.hpp"
+
+namespace {
+
+using primitives::primitive;
+
+template<typename TAction>
+void measure(char const* name, std::size_t count, TAction action) {
+    using clock = std::chrono::steady_clock;
+    int const repetitions = 20;
+    action();  // warm up
+    auto const start = clock::now();
+    for (int i = 0; i != repetitions; ++i) {
+        action();
+    }
+    auto const elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    std::cout << name << ": " << elapsed / (double(repetitions) * count) << " ns/element" << std::endl;
+}
+
+template<typename T>
+std::vector<primitive<T>> random_values(std::size_t count, T low, T high) {
+    std::mt19937_64 engine(42);
+    std::uniform_int_distribution<T> distribution(low, high);
+    std::vector<primitive<T>> values(count);
+    for (auto & value : values) {
+        value = primitive<T>(distribution(engine));
+    }
+    return values;
+}
+
+template<typename T>
+void benchmark_invariant_divisor(char const* type_name, T divisor_value) {
+    std::size_t const count = 1 << 20;
+    auto const values = random_values<T>(count, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    std::vector<primitive<T>> results(count);
+    // Keep the divisor opaque to the optimizer so the native loop really divides.
+    primitive<T> const opaque_divisor = [&] { volatile T opaque = divisor_value; return primitive<T>(T(opaque)); }();
+    primitives::invariant_divisor<T> const divisor(opaque_divisor);
+
+    std::cout << "-- division, " << type_name << std::endl;
+    measure("native /", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            results[i] = values[i] / opaque_divisor;
+        }
+    });
+    measure("invariant /", count, [&] {
+        divisor.divide(values.data(), count, results.data());
+    });
+    measure("native %", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            results[i] = values[i] % opaque_divisor;
+        }
+    });
+    measure("invariant %", count, [&] {
+        divisor.remainder(values.data(), count, results.data());
+    });
+    std::cout << "checksum " << results[count / 2] << std::endl;
+}
+
+void benchmark_endian_load() {
+    std::size_t const count = 1 << 14;
+    auto const values = random_values<std::uint32_t>(count, 0u, ~0u);
+    std::vector<primitives::primitive_be<std::uint32_t>> stored(count);
+    primitives::store(values.data(), count, stored.data());
+    std::vector<primitive<std::uint32_t>> results(count);
+
+    std::cout << "-- big endian load, uint32_t" << std::endl;
+    measure("memcpy + manual swap", count, [&] {
+        auto const bytes = reinterpret_cast<unsigned char const*>(stored.data());
+        for (std::size_t i = 0; i != count; ++i) {
+            std::uint32_t raw;
+            std::memcpy(&raw, bytes + i * sizeof(raw), sizeof(raw));
+            raw = (raw >> 24) | ((raw >> 8) & 0x0000FF00u) | ((raw << 8) & 0x00FF0000u) | (raw << 24);
+            results[i] = raw;
+        }
+    });
+    measure("per-element get", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            results[i] = stored[i].get();
+        }
+    });
+    measure("bulk load", count, [&] {
+        primitives::load(stored.data(), count, results.data());
+    });
+    std::cout << "checksum " << results[count / 2] << std::endl;
+}
+
+template<typename T>
+void benchmark_scan(char const* type_name, std::size_t count) {
+    std::vector<primitive<T>> values(count);
+    std::mt19937 engine(42);
+    for (auto & value : values) {
+        value = primitive<T>(T(engine() % 100));
+    }
+    std::vector<primitive<T>> results(count);
+
+    std::cout << "-- inclusive scan, " << type_name << ", " << count << " elements" << std::endl;
+#if __cplusplus >= 201703L
+    measure("std::inclusive_scan", count, [&] {
+        std::inclusive_scan(values.begin(), values.end(), results.begin());
+    });
+#else
+    measure("std::partial_sum", count, [&] {
+        std::partial_sum(values.begin(), values.end(), results.begin());
+    });
+#endif
+    measure("primitives::inclusive_scan", count, [&] {
+        primitives::inclusive_scan(values.data(), values.data() + count, results.data());
+    });
+    measure("primitives::inclusive_scan max", count, [&] {
+        primitives::inclusive_scan(values.data(), values.data() + count, results.data(), primitives::scan_max());
+    });
+    std::cout << "checksum " << results[count / 2] << std::endl;
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 native_int128;
+#endif
+
+void benchmark_wide_primitive() {
+    using Int128 = primitives::wide_primitive<128>;
+    std::size_t const count = 1 << 16;
+    auto const values = random_values<std::int64_t>(count, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max());
+    std::vector<Int128> wide(values.begin(), values.end());
+
+    std::cout << "-- 128-bit multiply-accumulate" << std::endl;
+    Int128 wide_total;
+    measure("wide_primitive<128>", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            wide_total += wide[i] * wide[count - i - 1];
+        }
+    });
+    std::cout << "checksum " << wide_total << std::endl;
+#if defined(__SIZEOF_INT128__)
+    std::vector<native_int128> native(count);
+    for (std::size_t i = 0; i != count; ++i) {
+        native[i] = values[i].get();
+    }
+    native_int128 native_total = 0;
+    measure("__int128", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            native_total += native[i] * native[count - i - 1];
+        }
+    });
+    std::cout << "checksum " << static_cast<long long>(native_total) << std::endl;
+#endif
+
+    std::cout << "-- 128-bit division by a 64-bit value" << std::endl;
+    Int128 const wide_divisor = Int128(primitive<std::int64_t>(1000000007));
+    measure("wide_primitive<128>", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            wide_total += (wide[i] << 32) / wide_divisor;
+        }
+    });
+    std::cout << "checksum " << wide_total << std::endl;
+#if defined(__SIZEOF_INT128__)
+    native_int128 const native_divisor = 1000000007;
+    measure("__int128", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            native_total += (native[i] << 32) / native_divisor;
+        }
+    });
+    std::cout << "checksum " << static_cast<long long>(native_total) << std::endl;
+#endif
+}
+
+void benchmark_half() {
+    std::size_t const count = std::size_t(1) << 22;
+    std::vector<primitive<float>> features(count);
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+    for (auto & feature : features) {
+        feature = distribution(engine);
+    }
+    std::vector<primitives::half> halves(count);
+    std::vector<primitives::bfloat16> bfloats(count);
+    std::vector<primitive<float>> widened(count);
+
+    std::cout << "-- half precision conversion" << std::endl;
+    measure("float -> half", count, [&] {
+        primitives::convert(features.data(), count, halves.data());
+    });
+    measure("half -> float", count, [&] {
+        primitives::convert(halves.data(), count, widened.data());
+    });
+    measure("float -> bfloat16", count, [&] {
+        primitives::convert(features.data(), count, bfloats.data());
+    });
+    measure("bfloat16 -> float", count, [&] {
+        primitives::convert(bfloats.data(), count, widened.data());
+    });
+
+    // Summing streams half the bytes from memory when the features are stored narrow.
+    std::cout << "-- half precision reduction" << std::endl;
+    primitive<float> total;
+    measure("sum float", count, [&] {
+        for (auto const& feature : features) {
+            total += feature;
+        }
+    });
+    primitive<float> buffer[1024];
+    measure("sum half (converted in blocks)", count, [&] {
+        for (std::size_t offset = 0; offset < count; offset += 1024) {
+            std::size_t const block = std::min<std::size_t>(1024, count - offset);
+            primitives::convert(halves.data() + offset, block, buffer);
+            for (std::size_t i = 0; i != block; ++i) {
+                total += buffer[i];
+            }
+        }
+    });
+    measure("sum bfloat16 (converted in blocks)", count, [&] {
+        for (std::size_t offset = 0; offset < count; offset += 1024) {
+            std::size_t const block = std::min<std::size_t>(1024, count - offset);
+            primitives::convert(bfloats.data() + offset, block, buffer);
+            for (std::size_t i = 0; i != block; ++i) {
+                total += buffer[i];
+            }
+        }
+    });
+    std::cout << "checksum " << total << std::endl;
+}
+
+void benchmark_dynamic_column() {
+    using primitives::dynamic_primitive_column;
+    std::size_t const count = std::size_t(1) << 20;
+    auto const quantities = random_values<int>(count, 0, 1000);
+    auto const prices = random_values<long long>(count, -100000, 100000);
+    auto const quantity_column = dynamic_primitive_column::from(quantities.data(), count);
+    auto const price_column = dynamic_primitive_column::from(prices.data(), count);
+
+    std::cout << "-- runtime-typed column multiply, int * long long" << std::endl;
+    long long checksum = 0;
+    measure("dynamic_primitive_column", count, [&] {
+        auto const totals = quantity_column * price_column;
+        checksum += totals.data<long long>()[count / 2].get();
+    });
+
+    // The alternative: every element carries its own type and is dispatched individually.
+    struct tagged {
+        primitives::primitive_kind kind;
+        union {
+            int int_value;
+            long long long_long_value;
+        };
+    };
+    std::vector<tagged> tagged_quantities(count);
+    std::vector<tagged> tagged_prices(count);
+    for (std::size_t i = 0; i != count; ++i) {
+        tagged_quantities[i].kind = primitives::primitive_kind::int_;
+        tagged_quantities[i].int_value = quantities[i].get();
+        tagged_prices[i].kind = primitives::primitive_kind::long_long;
+        tagged_prices[i].long_long_value = prices[i].get();
+    }
+    std::vector<primitive<long long>> totals(count);
+    auto const widen = [](tagged const& value) {
+        switch (value.kind) {
+            case primitives::primitive_kind::int_: return primitive<long long>(primitive<int>(value.int_value));
+            case primitives::primitive_kind::long_long: return primitive<long long>(value.long_long_value);
+            default: return primitive<long long>();
+        }
+    };
+    measure("per-element switch", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            totals[i] = widen(tagged_quantities[i]) * widen(tagged_prices[i]);
+        }
+        checksum += totals[count / 2].get();
+    });
+#if __cplusplus >= 201703L
+    using variant = std::variant<primitive<int>, primitive<long long>>;
+    std::vector<variant> variant_quantities(quantities.begin(), quantities.end());
+    std::vector<variant> variant_prices(prices.begin(), prices.end());
+    measure("per-element std::variant", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            totals[i] = std::visit([](auto const& lhs, auto const& rhs) {
+                return primitive<long long>(static_cast<long long>(lhs.get()) * static_cast<long long>(rhs.get()));
+            }, variant_quantities[i], variant_prices[i]);
+        }
+        checksum += totals[count / 2].get();
+    });
+#endif
+    std::cout << "checksum " << checksum << std::endl;
+}
+
+void benchmark_bit() {
+    std::size_t const count = std::size_t(1) << 20;
+    auto const values = random_values<std::uint64_t>(count, 0, std::numeric_limits<std::uint64_t>::max());
+    std::vector<primitive<std::uint64_t>> results(count);
+    std::uint64_t checksum = 0;
+
+    std::cout << "-- popcount, uint64_t" << std::endl;
+    measure("bit-at-a-time loop", count, [&] {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i != count; ++i) {
+            for (std::uint64_t value = values[i].get(); value != 0; value >>= 1) {
+                total += value & 1u;
+            }
+        }
+        checksum += total;
+    });
+    measure("per-element popcount", count, [&] {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i != count; ++i) {
+            total += std::uint64_t(primitives::popcount(values[i]).get());
+        }
+        checksum += total;
+    });
+    measure("span popcount", count, [&] {
+        checksum += primitives::popcount(values.data(), count).get();
+    });
+
+    std::cout << "-- bit manipulation, uint64_t" << std::endl;
+    measure("bit-at-a-time reverse", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            std::uint64_t value = values[i].get();
+            std::uint64_t reversed = 0;
+            for (int bit = 0; bit != 64; ++bit, value >>= 1) {
+                reversed = (reversed << 1) | (value & 1u);
+            }
+            results[i] = reversed;
+        }
+        checksum += results[count / 2].get();
+    });
+    measure("bit_reverse", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            results[i] = primitives::bit_reverse(values[i]);
+        }
+        checksum += results[count / 2].get();
+    });
+    primitive<std::uint64_t> const mask(std::uint64_t(0x0F0F0F0F0F0F0F0Full));
+    measure("extract_bits", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            results[i] = primitives::extract_bits(values[i], mask);
+        }
+        checksum += results[count / 2].get();
+    });
+    measure("deposit_bits", count, [&] {
+        for (std::size_t i = 0; i != count; ++i) {
+            results[i] = primitives::deposit_bits(values[i], mask);
+        }
+        checksum += results[count / 2].get();
+    });
+    measure("countl_zero", count, [&] {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i != count; ++i) {
+            total += std::uint64_t(primitives::countl_zero(values[i] >> std::uint64_t(i % 64)).get());
+        }
+        checksum += total;
+    });
+    std::cout << "checksum " << checksum << std::endl;
+}
+
+template<typename TIncrement>
+void run_threads(std::size_t thread_count, std::size_t increments, TIncrement increment) {
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (std::size_t t = 0; t != thread_count; ++t) {
+        threads.emplace_back([=] {
+            for (std::size_t i = 0; i != increments; ++i) {
+                increment();
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+}
+
+void benchmark_counter() {
+    std::size_t const total_increments = std::size_t(1) << 22;
+    std::cout << "-- counter increments, uint64_t (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    for (std::size_t thread_count = 1; thread_count <= 128; thread_count *= 2) {
+        std::size_t const increments = total_increments / thread_count;
+        std::string const threads = std::to_string(thread_count) + (thread_count == 1 ? " thread" : " threads");
+
+        std::atomic<std::uint64_t> single(0);
+        measure(("single atomic, " + threads).c_str(), total_increments, [&] {
+            run_threads(thread_count, increments, [&single] { single.fetch_add(1, std::memory_order_relaxed); });
+        });
+        primitives::primitive_counter<std::uint64_t> sharded;
+        measure(("primitive_counter, " + threads).c_str(), total_increments, [&] {
+            run_threads(thread_count, increments, [&sharded] { ++sharded; });
+        });
+        if (sharded.get().get() != single.load()) {
+            std::cout << "counter mismatch" << std::endl;
+        }
+    }
+}
+
+void benchmark_sparse_array() {
+    using sparse_array = primitives::sparse_primitive_array<double>;
+    std::size_t const count = std::size_t(1) << 24;
+    std::vector<primitive<double>> const weights(count, primitive<double>(0.5));
+    for (double const density : { 0.01, 0.05, 0.2 }) {
+        std::mt19937_64 engine(42);
+        std::bernoulli_distribution stored(density);
+        std::vector<primitive<double>> dense(count);
+        for (auto & value : dense) {
+            if (stored(engine)) {
+                value = 1.0 + double(engine() % 1000);
+            }
+        }
+        sparse_array const sparse = sparse_array::from(dense.data(), count);
+
+        std::cout << "-- sparse array, double, " << density * 100 << "% stored" << std::endl;
+        std::cout << "dense memory: " << dense.capacity() * sizeof(primitive<double>) / (1 << 20) << " MiB, sparse memory: "
+                  << sparse.memory_usage() / (1 << 20) << " MiB" << std::endl;
+        double checksum = 0;
+        measure("dense sum", count, [&] {
+            double total = 0;
+            for (std::size_t i = 0; i != count; ++i) {
+                total += dense[i].get();
+            }
+            checksum += total;
+        });
+        measure("sparse sum", count, [&] {
+            double total = 0;
+            sparse.for_each_stored([&total](std::size_t, primitive<double> const& value) { total += value.get(); });
+            checksum += total;
+        });
+        measure("dense dot", count, [&] {
+            double total = 0;
+            for (std::size_t i = 0; i != count; ++i) {
+                total += dense[i].get() * weights[i].get();
+            }
+            checksum += total;
+        });
+        measure("sparse dot", count, [&] {
+            checksum += primitives::dot(sparse, weights.data()).get();
+        });
+        std::cout << "checksum " << checksum << std::endl;
+    }
+}
+
+}  // namespace
+
+int main() {
+    benchmark_invariant_divisor<std::uint32_t>("uint32_t", 1000003u);
+    benchmark_invariant_divisor<std::int32_t>("int32_t", -7919);
+    benchmark_invariant_divisor<std::uint64_t>("uint64_t", 1000000007ull);
+    benchmark_invariant_divisor<std::int64_t>("int64_t", -1000000007ll);
+    benchmark_endian_load();
+    benchmark_scan<std::uint32_t>("uint32_t", std::size_t(1) << 14);
+    benchmark_scan<std::uint32_t>("uint32_t", std::size_t(1) << 24);
+    benchmark_scan<double>("double", std::size_t(1) << 14);
+    benchmark_wide_primitive();
+    benchmark_half();
+    benchmark_dynamic_column();
+    benchmark_bit();
+    benchmark_counter();
+    benchmark_sparse_array();
+}
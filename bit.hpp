@@ -0,0 +1,279 @@
+#ifndef BIT_HPP
+#define BIT_HPP
+
+#include "primitive.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// GCC and Clang builtins are usable in constant expressions and lower to popcnt, lzcnt, tzcnt and bswap when targeted.
+#if defined(__GNUC__) || defined(__clang__)
+#define PRIMITIVE_HAS_BIT_BUILTINS 1
+#endif
+
+#if defined(__BMI2__) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define PRIMITIVE_HAS_RUNTIME_BMI2 1
+#endif
+#endif
+
+namespace primitives {
+
+namespace detail {
+
+template<typename T>
+constexpr bool is_bit_integral() noexcept {
+    return std::is_integral<T>::value && !std::is_same<T, bool>::value;
+}
+
+template<typename U>
+constexpr int popcount(U value) noexcept {
+#if defined(PRIMITIVE_HAS_BIT_BUILTINS)
+    return __builtin_popcountll(static_cast<unsigned long long>(value));
+#else
+    int count = 0;
+    for (; value != 0; value = U(value & (value - 1))) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Without a popcnt target the builtin becomes a library call; the SWAR sum vectorizes instead.
+inline std::uint64_t popcount_word(std::uint64_t word) noexcept {
+#if defined(__POPCNT__)
+    return std::uint64_t(popcount(word));
+#else
+    word -= (word >> 1) & 0x5555555555555555ull;
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (word * 0x0101010101010101ull) >> 56;
+#endif
+}
+
+template<typename U>
+constexpr int countl_zero(U value) noexcept {
+    constexpr int digits = std::numeric_limits<U>::digits;
+    if (value == 0) {
+        return digits;
+    }
+#if defined(PRIMITIVE_HAS_BIT_BUILTINS)
+    return __builtin_clzll(static_cast<unsigned long long>(value)) - (std::numeric_limits<unsigned long long>::digits - digits);
+#else
+    int count = 0;
+    for (U mask = U(U(1) << (digits - 1)); (value & mask) == 0; mask = U(mask >> 1)) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+template<typename U>
+constexpr int countr_zero(U value) noexcept {
+    constexpr int digits = std::numeric_limits<U>::digits;
+    if (value == 0) {
+        return digits;
+    }
+#if defined(PRIMITIVE_HAS_BIT_BUILTINS)
+    return __builtin_ctzll(static_cast<unsigned long long>(value));
+#else
+    int count = 0;
+    for (; (value & 1u) == 0; value = U(value >> 1)) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+template<typename U>
+constexpr U rotl(U value, int shift) noexcept {
+    constexpr int digits = std::numeric_limits<U>::digits;
+    int const amount = ((shift % digits) + digits) % digits;
+    return amount == 0 ? value : U(U(value << amount) | U(value >> (digits - amount)));
+}
+
+template<typename U>
+constexpr U reverse_bytes(U value) noexcept {
+#if defined(PRIMITIVE_HAS_BIT_BUILTINS)
+    return sizeof(U) == 1 ? value
+        : sizeof(U) == 2 ? U(__builtin_bswap16(std::uint16_t(value)))
+        : sizeof(U) == 4 ? U(__builtin_bswap32(std::uint32_t(value)))
+        : U(__builtin_bswap64(std::uint64_t(value)));
+#else
+    U result = 0;
+    for (std::size_t index = 0; index != sizeof(U); ++index) {
+        result = U(U(result << 8) | U(value & 0xFFu));
+        value = U(value >> 8);
+    }
+    return result;
+#endif
+}
+
+// Reverses the bits within each byte with three mask-and-swap steps, then reverses the bytes.
+template<typename U>
+constexpr U bit_reverse(U value) noexcept {
+    U const nibbles = U(~U() / 0xFFu * 0x0Fu);
+    U const pairs = U(~U() / 0xFFu * 0x33u);
+    U const bits = U(~U() / 0xFFu * 0x55u);
+    value = U(U(U(value >> 4) & nibbles) | U(U(value & nibbles) << 4));
+    value = U(U(U(value >> 2) & pairs) | U(U(value & pairs) << 2));
+    value = U(U(U(value >> 1) & bits) | U(U(value & bits) << 1));
+    return reverse_bytes(value);
+}
+
+template<typename U>
+constexpr U deposit_bits(U value, U mask) noexcept {
+#if defined(PRIMITIVE_HAS_RUNTIME_BMI2)
+    if (!__builtin_is_constant_evaluated()) {
+        return sizeof(U) <= 4
+            ? U(_pdep_u32(std::uint32_t(value), std::uint32_t(mask)))
+            : U(_pdep_u64(std::uint64_t(value), std::uint64_t(mask)));
+    }
+#endif
+    U result = 0;
+    for (int index = 0; mask != 0; ++index) {
+        U const lowest = U(mask & U(U(0) - mask));
+        result = U(result | U(lowest & U(U(0) - U(U(value >> index) & 1u))));
+        mask = U(mask & U(mask - 1));
+    }
+    return result;
+}
+
+template<typename U>
+constexpr U extract_bits(U value, U mask) noexcept {
+#if defined(PRIMITIVE_HAS_RUNTIME_BMI2)
+    if (!__builtin_is_constant_evaluated()) {
+        return sizeof(U) <= 4
+            ? U(_pext_u32(std::uint32_t(value), std::uint32_t(mask)))
+            : U(_pext_u64(std::uint64_t(value), std::uint64_t(mask)));
+    }
+#endif
+    U result = 0;
+    for (int index = 0; mask != 0; ++index) {
+        U const lowest = U(mask & U(U(0) - mask));
+        result = U(result | U(U((value & lowest) != 0) << index));
+        mask = U(mask & U(mask - 1));
+    }
+    return result;
+}
+
+}  // namespace detail
+
+// The bit functions work on the two's complement representation, so they accept signed primitives too.
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<int> popcount(primitive<T> const& value) noexcept {
+    return primitive<int>(detail::popcount(std::make_unsigned_t<T>(value.get())));
+}
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<int> countl_zero(primitive<T> const& value) noexcept {
+    return primitive<int>(detail::countl_zero(std::make_unsigned_t<T>(value.get())));
+}
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<int> countr_zero(primitive<T> const& value) noexcept {
+    return primitive<int>(detail::countr_zero(std::make_unsigned_t<T>(value.get())));
+}
+
+// Returns the index of the highest set bit, or -1 for zero.
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<int> floor_log2(primitive<T> const& value) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return primitive<int>(std::numeric_limits<U>::digits - 1 - detail::countl_zero(U(value.get())));
+}
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<T> rotl(primitive<T> const& value, primitive<int> const& shift) noexcept {
+    return primitive<T>(T(detail::rotl(std::make_unsigned_t<T>(value.get()), shift.get())));
+}
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<T> rotr(primitive<T> const& value, primitive<int> const& shift) noexcept {
+    return primitive<T>(T(detail::rotl(std::make_unsigned_t<T>(value.get()), -(shift.get() % std::numeric_limits<std::make_unsigned_t<T>>::digits))));
+}
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<T> byteswap(primitive<T> const& value) noexcept {
+    return primitive<T>(T(detail::reverse_bytes(std::make_unsigned_t<T>(value.get()))));
+}
+
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<T> bit_reverse(primitive<T> const& value) noexcept {
+    return primitive<T>(T(detail::bit_reverse(std::make_unsigned_t<T>(value.get()))));
+}
+
+// Scatters the low bits of value to the set bits of mask, like the BMI2 pdep instruction.
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<T> deposit_bits(primitive<T> const& value, primitive<T> const& mask) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return primitive<T>(T(detail::deposit_bits(U(value.get()), U(mask.get()))));
+}
+
+// Gathers the bits of value selected by mask into the low bits, like the BMI2 pext instruction.
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+constexpr primitive<T> extract_bits(primitive<T> const& value, primitive<T> const& mask) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return primitive<T>(T(detail::extract_bits(U(value.get()), U(mask.get()))));
+}
+
+// Counts the set bits across count values, 32 or 64 bytes at a time with AVX2 or AVX-512 VPOPCNTDQ when targeted.
+template<typename T, typename = std::enable_if_t< detail::is_bit_integral<T>() >>
+primitive<std::uint64_t> popcount(primitive<T> const* values, std::size_t count) noexcept {
+    auto const bytes = reinterpret_cast<unsigned char const*>(values);
+    std::size_t const size = count * sizeof(T);
+    std::size_t index = 0;
+    std::uint64_t total = 0;
+#if defined(__AVX512VPOPCNTDQ__) || defined(__AVX2__)
+    // Counting up to a cache line boundary first keeps the vector loads from splitting lines.
+    for (; index < size && reinterpret_cast<std::uintptr_t>(bytes + index) % 64 != 0; ++index) {
+        total += std::uint64_t(detail::popcount(bytes[index]));
+    }
+#endif
+#if defined(__AVX512VPOPCNTDQ__)
+    __m512i wide_sums = _mm512_setzero_si512();
+    for (; index + 64 <= size; index += 64) {
+        __m512i const block = _mm512_loadu_si512(bytes + index);
+        wide_sums = _mm512_add_epi64(wide_sums, _mm512_popcnt_epi64(block));
+    }
+    std::uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, wide_sums);
+    for (std::uint64_t lane : lanes) {
+        total += lane;
+    }
+#endif
+#if defined(__AVX2__)
+    // Looks up the bit count of each nibble with a byte shuffle (W. Mula's method).
+    __m256i const lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i const low_nibbles = _mm256_set1_epi8(0x0F);
+    __m256i sums = _mm256_setzero_si256();
+    for (; index + 32 <= size; index += 32) {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes + index));
+        __m256i const low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(block, low_nibbles));
+        __m256i const high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibbles));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+    total += std::uint64_t(_mm256_extract_epi64(sums, 0)) + std::uint64_t(_mm256_extract_epi64(sums, 1))
+        + std::uint64_t(_mm256_extract_epi64(sums, 2)) + std::uint64_t(_mm256_extract_epi64(sums, 3));
+#endif
+    for (; index + 8 <= size; index += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + index, sizeof(word));
+        total += detail::popcount_word(word);
+    }
+    for (; index < size; ++index) {
+        total += std::uint64_t(detail::popcount(bytes[index]));
+    }
+    return primitive<std::uint64_t>(total);
+}
+
+}  // namespace primitives
+
+#endif
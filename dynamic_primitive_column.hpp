@@ -0,0 +1,329 @@
+#ifndef DYNAMIC_PRIMITIVE_COLUMN_HPP
+#define DYNAMIC_PRIMITIVE_COLUMN_HPP
+
+#include "primitive.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace primitives {
+
+// Identifies the value_type of a primitive when it is only known at runtime.
+enum class primitive_kind : unsigned char {
+    boolean,
+    char_,
+    schar,
+    uchar,
+    short_,
+    ushort,
+    int_,
+    uint,
+    long_,
+    ulong,
+    long_long,
+    ulong_long,
+    float_,
+    double_,
+    long_double
+};
+
+namespace detail {
+
+constexpr std::size_t primitive_kind_count = 15;
+
+template<primitive_kind Kind> struct kind_type;
+template<> struct kind_type<primitive_kind::boolean> { using type = bool; };
+template<> struct kind_type<primitive_kind::char_> { using type = char; };
+template<> struct kind_type<primitive_kind::schar> { using type = signed char; };
+template<> struct kind_type<primitive_kind::uchar> { using type = unsigned char; };
+template<> struct kind_type<primitive_kind::short_> { using type = short; };
+template<> struct kind_type<primitive_kind::ushort> { using type = unsigned short; };
+template<> struct kind_type<primitive_kind::int_> { using type = int; };
+template<> struct kind_type<primitive_kind::uint> { using type = unsigned int; };
+template<> struct kind_type<primitive_kind::long_> { using type = long; };
+template<> struct kind_type<primitive_kind::ulong> { using type = unsigned long; };
+template<> struct kind_type<primitive_kind::long_long> { using type = long long; };
+template<> struct kind_type<primitive_kind::ulong_long> { using type = unsigned long long; };
+template<> struct kind_type<primitive_kind::float_> { using type = float; };
+template<> struct kind_type<primitive_kind::double_> { using type = double; };
+template<> struct kind_type<primitive_kind::long_double> { using type = long double; };
+
+template<std::size_t Index>
+using kind_type_t = typename kind_type<static_cast<primitive_kind>(Index)>::type;
+
+// Follows arithmetic_traits.h rather than the language's usual arithmetic conversions.
+template<typename T1, typename T2>
+constexpr std::size_t promoted_index(std::size_t lhs, std::size_t rhs) noexcept {
+    return std::is_same<T1, T2>::value || is_promotion<T1, T2>::value ? rhs
+        : is_promotion<T2, T1>::value ? lhs
+        : primitive_kind_count;
+}
+
+struct promotion_table {
+    unsigned char entries[primitive_kind_count * primitive_kind_count];
+};
+
+template<std::size_t... Indexes>
+constexpr promotion_table make_promotion_table(std::index_sequence<Indexes...>) noexcept {
+    return promotion_table{ {
+        static_cast<unsigned char>(promoted_index<
+            kind_type_t<Indexes / primitive_kind_count>,
+            kind_type_t<Indexes % primitive_kind_count>
+        >(Indexes / primitive_kind_count, Indexes % primitive_kind_count))...
+    } };
+}
+
+}  // namespace detail
+
+// Only the kinds above have a specialization; the wide character types wrap in primitive but not in a column.
+template<typename T>
+constexpr primitive_kind kind_of() noexcept {
+    static_assert(!std::is_same<T, T>::value,
+        "dynamic_primitive_column cannot hold this type; wchar_t, char16_t and char32_t are not column kinds.");
+    return primitive_kind::boolean;
+}
+
+template<> constexpr primitive_kind kind_of<bool>() noexcept { return primitive_kind::boolean; }
+template<> constexpr primitive_kind kind_of<char>() noexcept { return primitive_kind::char_; }
+template<> constexpr primitive_kind kind_of<signed char>() noexcept { return primitive_kind::schar; }
+template<> constexpr primitive_kind kind_of<unsigned char>() noexcept { return primitive_kind::uchar; }
+template<> constexpr primitive_kind kind_of<short>() noexcept { return primitive_kind::short_; }
+template<> constexpr primitive_kind kind_of<unsigned short>() noexcept { return primitive_kind::ushort; }
+template<> constexpr primitive_kind kind_of<int>() noexcept { return primitive_kind::int_; }
+template<> constexpr primitive_kind kind_of<unsigned int>() noexcept { return primitive_kind::uint; }
+template<> constexpr primitive_kind kind_of<long>() noexcept { return primitive_kind::long_; }
+template<> constexpr primitive_kind kind_of<unsigned long>() noexcept { return primitive_kind::ulong; }
+template<> constexpr primitive_kind kind_of<long long>() noexcept { return primitive_kind::long_long; }
+template<> constexpr primitive_kind kind_of<unsigned long long>() noexcept { return primitive_kind::ulong_long; }
+template<> constexpr primitive_kind kind_of<float>() noexcept { return primitive_kind::float_; }
+template<> constexpr primitive_kind kind_of<double>() noexcept { return primitive_kind::double_; }
+template<> constexpr primitive_kind kind_of<long double>() noexcept { return primitive_kind::long_double; }
+
+namespace detail {
+
+inline std::size_t promotion_entry(primitive_kind lhs, primitive_kind rhs) noexcept {
+    static constexpr promotion_table table =
+        make_promotion_table(std::make_index_sequence<primitive_kind_count * primitive_kind_count>());
+    return table.entries[std::size_t(lhs) * primitive_kind_count + std::size_t(rhs)];
+}
+
+}  // namespace detail
+
+// Returns whether values of the two kinds can be combined, i.e., one is the same as or promotes to the other.
+inline bool can_promote(primitive_kind lhs, primitive_kind rhs) noexcept {
+    return detail::promotion_entry(lhs, rhs) != detail::primitive_kind_count;
+}
+
+// Returns the kind two columns combine into, looked up in a table generated from is_promotion.
+inline primitive_kind promote(primitive_kind lhs, primitive_kind rhs) {
+    std::size_t const result = detail::promotion_entry(lhs, rhs);
+    if (result == detail::primitive_kind_count) {
+        throw std::invalid_argument("The primitive kinds do not promote to a common kind.");
+    }
+    return static_cast<primitive_kind>(result);
+}
+
+template<typename T>
+struct kind_tag {
+    using type = T;
+};
+
+// Calls visitor with a kind_tag<T> for the value_type named by kind; this is the only per-batch type switch.
+template<typename TVisitor>
+decltype(auto) visit(primitive_kind kind, TVisitor&& visitor) {
+    switch (kind) {
+        case primitive_kind::boolean: return visitor(kind_tag<bool>());
+        case primitive_kind::char_: return visitor(kind_tag<char>());
+        case primitive_kind::schar: return visitor(kind_tag<signed char>());
+        case primitive_kind::uchar: return visitor(kind_tag<unsigned char>());
+        case primitive_kind::short_: return visitor(kind_tag<short>());
+        case primitive_kind::ushort: return visitor(kind_tag<unsigned short>());
+        case primitive_kind::int_: return visitor(kind_tag<int>());
+        case primitive_kind::uint: return visitor(kind_tag<unsigned int>());
+        case primitive_kind::long_: return visitor(kind_tag<long>());
+        case primitive_kind::ulong: return visitor(kind_tag<unsigned long>());
+        case primitive_kind::long_long: return visitor(kind_tag<long long>());
+        case primitive_kind::ulong_long: return visitor(kind_tag<unsigned long long>());
+        case primitive_kind::float_: return visitor(kind_tag<float>());
+        case primitive_kind::double_: return visitor(kind_tag<double>());
+        case primitive_kind::long_double: return visitor(kind_tag<long double>());
+    }
+    throw std::invalid_argument("Unknown primitive kind.");
+}
+
+inline std::size_t size_of(primitive_kind kind) {
+    return visit(kind, [](auto tag) { return sizeof(typename decltype(tag)::type); });
+}
+
+// A column of primitives whose value_type is chosen at runtime. Values start zeroed, like primitive.
+class dynamic_primitive_column final {
+public:
+    // Storage is aligned for the widest vector loads.
+    static constexpr std::size_t alignment = 64;
+
+private:
+    primitive_kind m_kind;
+    std::size_t m_size;
+    std::unique_ptr<unsigned char[]> m_storage;
+    unsigned char* m_data;
+
+    template<typename T>
+    void check_kind() const {
+        if (kind_of<T>() != m_kind) {
+            throw std::invalid_argument("The column does not hold the requested primitive kind.");
+        }
+    }
+
+public:
+    dynamic_primitive_column(primitive_kind kind, std::size_t size)
+        : m_kind(kind),
+          m_size(size),
+          m_storage(new unsigned char[size * size_of(kind) + alignment]),
+          m_data(m_storage.get() + (alignment - reinterpret_cast<std::uintptr_t>(m_storage.get()) % alignment) % alignment) {
+        std::memset(m_data, 0, size * size_of(kind));
+    }
+
+    template<typename T>
+    static dynamic_primitive_column from(primitive<T> const* values, std::size_t count) {
+        dynamic_primitive_column column(kind_of<T>(), count);
+        std::memcpy(column.m_data, values, count * sizeof(T));
+        return column;
+    }
+
+    dynamic_primitive_column(dynamic_primitive_column const& other)
+        : dynamic_primitive_column(other.m_kind, other.m_size) {
+        if (m_size != 0) {
+            std::memcpy(m_data, other.m_data, m_size * size_of(m_kind));
+        }
+    }
+    // A moved-from column is empty, so it never points into storage that another column now owns.
+    dynamic_primitive_column(dynamic_primitive_column && other) noexcept
+        : m_kind(other.m_kind),
+          m_size(other.m_size),
+          m_storage(std::move(other.m_storage)),
+          m_data(other.m_data) {
+        other.m_size = 0;
+        other.m_data = nullptr;
+    }
+
+    dynamic_primitive_column& operator=(dynamic_primitive_column const& other) {
+        return *this = dynamic_primitive_column(other);
+    }
+    dynamic_primitive_column& operator=(dynamic_primitive_column && other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        m_kind = other.m_kind;
+        m_size = other.m_size;
+        m_storage = std::move(other.m_storage);
+        m_data = other.m_data;
+        other.m_size = 0;
+        other.m_data = nullptr;
+        return *this;
+    }
+
+    primitive_kind kind() const noexcept { return m_kind; }
+    std::size_t size() const noexcept { return m_size; }
+
+    // Typed access; throws std::invalid_argument if T is not the column's kind.
+    template<typename T>
+    primitive<T>* data() {
+        check_kind<T>();
+        return reinterpret_cast<primitive<T>*>(m_data);
+    }
+    template<typename T>
+    primitive<T> const* data() const {
+        check_kind<T>();
+        return reinterpret_cast<primitive<T> const*>(m_data);
+    }
+};
+
+// The column operations apply primitive<T>'s compound assignments, so a result stays in the column's promoted
+// type the way a += b does (a short column wraps in short instead of widening to int like short + short).
+struct column_plus {
+    template<typename T>
+    primitive<T> operator()(primitive<T> lhs, primitive<T> const& rhs) const noexcept { return lhs += rhs; }
+};
+
+struct column_minus {
+    template<typename T>
+    primitive<T> operator()(primitive<T> lhs, primitive<T> const& rhs) const noexcept { return lhs -= rhs; }
+};
+
+struct column_multiplies {
+    template<typename T>
+    primitive<T> operator()(primitive<T> lhs, primitive<T> const& rhs) const noexcept { return lhs *= rhs; }
+};
+
+struct column_divides {
+    template<typename T>
+    primitive<T> operator()(primitive<T> lhs, primitive<T> const& rhs) const noexcept { return lhs /= rhs; }
+};
+
+namespace detail {
+
+// Both inputs are promoted to primitive<TResult> before the operation, the same conversion an assignment would do.
+template<typename TResult, typename T1, typename T2, typename Op>
+void column_kernel(primitive<T1> const* lhs, primitive<T2> const* rhs, primitive<TResult>* result, std::size_t count, Op op) noexcept {
+    for (std::size_t index = 0; index != count; ++index) {
+        result[index] = op(primitive<TResult>(lhs[index]), primitive<TResult>(rhs[index]));
+    }
+}
+
+template<typename T1, typename T2>
+constexpr bool is_column_arithmetic() noexcept {
+    return !std::is_same<T1, bool>::value && !std::is_same<T2, bool>::value
+        && (std::is_same<T1, T2>::value || is_promotion<T1, T2>::value || is_promotion<T2, T1>::value);
+}
+
+template<typename T1, typename T2, typename Op>
+void apply_column(dynamic_primitive_column const& lhs, dynamic_primitive_column const& rhs, dynamic_primitive_column& result, Op op, std::true_type) {
+    using TResult = std::conditional_t< std::is_same<T1, T2>::value || is_promotion<T1, T2>::value, T2, T1 >;
+    column_kernel<TResult>(lhs.data<T1>(), rhs.data<T2>(), result.data<TResult>(), lhs.size(), op);
+}
+
+template<typename T1, typename T2, typename Op>
+void apply_column(dynamic_primitive_column const&, dynamic_primitive_column const&, dynamic_primitive_column&, Op, std::false_type) {
+    throw std::invalid_argument("Arithmetic is not supported between these primitive kinds.");
+}
+
+template<typename Op>
+dynamic_primitive_column apply_column(dynamic_primitive_column const& lhs, dynamic_primitive_column const& rhs, Op op) {
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument("The columns are not the same size.");
+    }
+    dynamic_primitive_column result(promote(lhs.kind(), rhs.kind()), lhs.size());
+    visit(lhs.kind(), [&](auto lhs_tag) {
+        visit(rhs.kind(), [&](auto rhs_tag) {
+            using T1 = typename decltype(lhs_tag)::type;
+            using T2 = typename decltype(rhs_tag)::type;
+            apply_column<T1, T2>(lhs, rhs, result, op, std::integral_constant<bool, is_column_arithmetic<T1, T2>()>());
+        });
+    });
+    return result;
+}
+
+}  // namespace detail
+
+// Element-wise arithmetic; the result has the promoted kind of the two columns.
+inline dynamic_primitive_column operator+(dynamic_primitive_column const& lhs, dynamic_primitive_column const& rhs) {
+    return detail::apply_column(lhs, rhs, column_plus());
+}
+inline dynamic_primitive_column operator-(dynamic_primitive_column const& lhs, dynamic_primitive_column const& rhs) {
+    return detail::apply_column(lhs, rhs, column_minus());
+}
+inline dynamic_primitive_column operator*(dynamic_primitive_column const& lhs, dynamic_primitive_column const& rhs) {
+    return detail::apply_column(lhs, rhs, column_multiplies());
+}
+inline dynamic_primitive_column operator/(dynamic_primitive_column const& lhs, dynamic_primitive_column const& rhs) {
+    return detail::apply_column(lhs, rhs, column_divides());
+}
+
+}  // namespace primitives
+
+#endif
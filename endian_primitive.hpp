@@ -0,0 +1,207 @@
+#ifndef ENDIAN_PRIMITIVE_HPP
+#define ENDIAN_PRIMITIVE_HPP
+
+#include "primitive.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace primitives {
+
+enum class byte_order { little, big };
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr byte_order native_byte_order = byte_order::big;
+#else
+constexpr byte_order native_byte_order = byte_order::little;
+#endif
+
+namespace detail {
+
+inline std::uint8_t byteswap(std::uint8_t value) noexcept { return value; }
+
+inline std::uint16_t byteswap(std::uint16_t value) noexcept {
+#if defined(_MSC_VER)
+    return _byteswap_ushort(value);
+#elif defined(__GNUC__)
+    return __builtin_bswap16(value);
+#else
+    return std::uint16_t((value >> 8) | (value << 8));
+#endif
+}
+
+inline std::uint32_t byteswap(std::uint32_t value) noexcept {
+#if defined(_MSC_VER)
+    return _byteswap_ulong(value);
+#elif defined(__GNUC__)
+    return __builtin_bswap32(value);
+#else
+    return (value >> 24) | ((value >> 8) & 0x0000FF00u) | ((value << 8) & 0x00FF0000u) | (value << 24);
+#endif
+}
+
+inline std::uint64_t byteswap(std::uint64_t value) noexcept {
+#if defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#elif defined(__GNUC__)
+    return __builtin_bswap64(value);
+#else
+    return (std::uint64_t(byteswap(std::uint32_t(value))) << 32) | byteswap(std::uint32_t(value >> 32));
+#endif
+}
+
+template<std::size_t Size> struct unsigned_of_size;
+template<> struct unsigned_of_size<1> { using type = std::uint8_t; };
+template<> struct unsigned_of_size<2> { using type = std::uint16_t; };
+template<> struct unsigned_of_size<4> { using type = std::uint32_t; };
+template<> struct unsigned_of_size<8> { using type = std::uint64_t; };
+
+template<typename T, byte_order Order>
+inline T load_ordered(unsigned char const* bytes) noexcept {
+    using U = typename unsigned_of_size<sizeof(T)>::type;
+    U raw;
+    std::memcpy(&raw, bytes, sizeof(U));
+    if (Order != native_byte_order) {
+        raw = byteswap(raw);
+    }
+    T value;
+    std::memcpy(&value, &raw, sizeof(T));
+    return value;
+}
+
+template<typename T, byte_order Order>
+inline void store_ordered(unsigned char* bytes, T value) noexcept {
+    using U = typename unsigned_of_size<sizeof(T)>::type;
+    U raw;
+    std::memcpy(&raw, &value, sizeof(U));
+    if (Order != native_byte_order) {
+        raw = byteswap(raw);
+    }
+    std::memcpy(bytes, &raw, sizeof(U));
+}
+
+// Reverses each Size-byte group in count elements; source and destination may be the same.
+template<std::size_t Size>
+inline void byteswap_elements(unsigned char const* source, unsigned char* destination, std::size_t count) noexcept {
+    using U = typename unsigned_of_size<Size>::type;
+    std::size_t index = 0;
+#if defined(__SSSE3__)
+    if (Size > 1) {
+        __m128i const mask = Size == 2
+            ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+            : Size == 4
+                ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        std::size_t const per_vector = 16 / Size;
+        std::size_t const vector_count = count - count % per_vector;
+        for (; index != vector_count; index += per_vector) {
+            __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + index * Size));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index * Size), _mm_shuffle_epi8(block, mask));
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        U raw;
+        std::memcpy(&raw, source + index * Size, Size);
+        raw = byteswap(raw);
+        std::memcpy(destination + index * Size, &raw, Size);
+    }
+}
+
+}  // namespace detail
+
+// Stores an arithmetic value in a fixed byte order with alignment 1, so it can overlay raw buffers directly.
+template<typename T, byte_order Order, typename = std::enable_if_t< std::is_arithmetic<T>::value >>
+class endian_primitive final {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+        "Only 1, 2, 4 and 8 byte types have a fixed byte order.");
+
+    unsigned char m_bytes[sizeof(T)];
+
+public:
+    using value_type = T;
+    static constexpr byte_order order = Order;
+
+    endian_primitive() noexcept : m_bytes() {}
+
+    template<typename U, typename = std::enable_if_t<
+         std::is_same<T, U>::value || is_promotion<U, T>::value
+    >>
+    endian_primitive(U const& value) noexcept {
+        detail::store_ordered<T, Order>(m_bytes, T(value));
+    }
+
+    template<typename U, typename = std::enable_if_t< std::is_same<T, U>::value || is_promotion<U, T>::value >>
+    endian_primitive(primitive<U> const& other) noexcept {
+        detail::store_ordered<T, Order>(m_bytes, T(other.get()));
+    }
+
+    template<typename U, typename = std::enable_if_t< is_conversion<U, T>::value >>
+    static endian_primitive from(U const& other) noexcept {
+        return endian_primitive(T(other));
+    }
+
+    endian_primitive(endian_primitive const&) = default;
+    endian_primitive& operator=(endian_primitive const&) = default;
+
+    // Reads the stored value in native byte order.
+    primitive<T> get() const noexcept {
+        return primitive<T>(detail::load_ordered<T, Order>(m_bytes));
+    }
+};
+
+template<typename T>
+using primitive_le = endian_primitive<T, byte_order::little>;
+
+template<typename T>
+using primitive_be = endian_primitive<T, byte_order::big>;
+
+template<typename T, byte_order Order>
+bool operator==(endian_primitive<T, Order> const& lhs, endian_primitive<T, Order> const& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+template<typename T, byte_order Order>
+bool operator!=(endian_primitive<T, Order> const& lhs, endian_primitive<T, Order> const& rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+// Converts count fixed-order values into native primitives, byte swapping in bulk when the orders differ.
+template<typename T, byte_order Order>
+primitive<T>* load(endian_primitive<T, Order> const* source, std::size_t count, primitive<T>* destination) noexcept {
+    static_assert(sizeof(endian_primitive<T, Order>) == sizeof(T), "The endian storage has overhead.");
+    static_assert(sizeof(primitive<T>) == sizeof(T), "The primitive wrapper has overhead.");
+    auto const bytes = reinterpret_cast<unsigned char const*>(source);
+    auto const target = reinterpret_cast<unsigned char*>(destination);
+    if (Order == native_byte_order) {
+        std::memmove(target, bytes, count * sizeof(T));
+    } else {
+        detail::byteswap_elements<sizeof(T)>(bytes, target, count);
+    }
+    return destination + count;
+}
+
+// Converts count native primitives into fixed-order storage, byte swapping in bulk when the orders differ.
+template<typename T, byte_order Order>
+endian_primitive<T, Order>* store(primitive<T> const* source, std::size_t count, endian_primitive<T, Order>* destination) noexcept {
+    static_assert(sizeof(endian_primitive<T, Order>) == sizeof(T), "The endian storage has overhead.");
+    static_assert(sizeof(primitive<T>) == sizeof(T), "The primitive wrapper has overhead.");
+    auto const bytes = reinterpret_cast<unsigned char const*>(source);
+    auto const target = reinterpret_cast<unsigned char*>(destination);
+    if (Order == native_byte_order) {
+        std::memmove(target, bytes, count * sizeof(T));
+    } else {
+        detail::byteswap_elements<sizeof(T)>(bytes, target, count);
+    }
+    return destination + count;
+}
+
+}  // namespace primitives
+
+#endif
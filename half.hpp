@@ -0,0 +1,272 @@
+#ifndef HALF_HPP
+#define HALF_HPP
+
+#include "primitive.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if defined(__F16C__) || defined(__AVX512F__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+namespace primitives {
+
+class half;
+class bfloat16;
+
+}  // namespace primitives
+
+template<> struct is_promotion<primitives::half, float> : std::true_type {};
+template<> struct is_promotion<primitives::half, double> : std::true_type {};
+template<> struct is_promotion<primitives::half, long double> : std::true_type {};
+template<> struct is_promotion<primitives::bfloat16, float> : std::true_type {};
+template<> struct is_promotion<primitives::bfloat16, double> : std::true_type {};
+template<> struct is_promotion<primitives::bfloat16, long double> : std::true_type {};
+
+template<> struct is_conversion<float, primitives::half> : std::true_type {};
+template<> struct is_conversion<double, primitives::half> : std::true_type {};
+template<> struct is_conversion<float, primitives::bfloat16> : std::true_type {};
+template<> struct is_conversion<double, primitives::bfloat16> : std::true_type {};
+
+namespace primitives {
+
+namespace detail {
+
+inline std::uint32_t float_bits(float value) noexcept {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bits_float(std::uint32_t bits) noexcept {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Rounds to nearest even; overflow becomes infinity and NaNs become quiet NaNs (after F. Giesen, "float_to_half_fast3_rtne").
+inline std::uint16_t float_to_half_bits(float value) noexcept {
+    std::uint32_t const f32_infinity = 255u << 23;
+    std::uint32_t const f16_overflow = (127u + 16u) << 23;
+    std::uint32_t const denormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+    std::uint32_t bits = float_bits(value);
+    std::uint32_t const sign = bits & 0x80000000u;
+    bits ^= sign;
+    std::uint16_t result;
+    if (bits >= f16_overflow) {
+        result = bits > f32_infinity ? std::uint16_t(0x7E00u | ((bits >> 13) & 0x3FFu)) : std::uint16_t(0x7C00u);
+    } else if (bits < (113u << 23)) {
+        // The float addition aligns the mantissa and rounds it into the half's denormal range.
+        result = std::uint16_t(float_bits(bits_float(bits) + bits_float(denormal_magic)) - denormal_magic);
+    } else {
+        std::uint32_t const odd_mantissa = (bits >> 13) & 1u;
+        bits += ((15u - 127u) << 23) + 0xFFFu;
+        bits += odd_mantissa;
+        result = std::uint16_t(bits >> 13);
+    }
+    return std::uint16_t(result | (sign >> 16));
+}
+
+inline float half_bits_to_float(std::uint16_t bits) noexcept {
+    std::uint32_t const shifted_exponent = 0x7C00u << 13;
+    std::uint32_t result = (bits & 0x7FFFu) << 13;
+    std::uint32_t const exponent = shifted_exponent & result;
+    result += (127u - 15u) << 23;
+    if (exponent == shifted_exponent) {
+        result += (128u - 16u) << 23;
+        result |= (bits & 0x03FFu) != 0 ? 0x00400000u : 0u;
+    } else if (exponent == 0) {
+        result += 1u << 23;
+        result = float_bits(bits_float(result) - bits_float(113u << 23));
+    }
+    return bits_float(result | (std::uint32_t(bits & 0x8000u) << 16));
+}
+
+// Rounds to nearest even on the upper 16 bits; NaNs are kept quiet so rounding cannot turn them into infinity.
+inline std::uint16_t float_to_bfloat16_bits(float value) noexcept {
+    std::uint32_t const bits = float_bits(value);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return std::uint16_t((bits >> 16) | 0x0040u);
+    }
+    return std::uint16_t((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+inline float bfloat16_bits_to_float(std::uint16_t bits) noexcept {
+    return bits_float(std::uint32_t(bits) << 16);
+}
+
+// Rounds a double to nearest even in a 16-bit format with one rounding step from the 52-bit mantissa; going
+// through float first would round twice. NaNs keep their top payload bits and become quiet.
+template<int ExponentBits, int MantissaBits>
+std::uint16_t double_to_narrow_bits(double value) noexcept {
+    constexpr int bias = (1 << (ExponentBits - 1)) - 1;
+    constexpr std::uint32_t infinity = ((1u << ExponentBits) - 1u) << MantissaBits;
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::uint32_t const sign = std::uint32_t(bits >> 63) << (ExponentBits + MantissaBits);
+    std::uint64_t const mantissa = bits & ((std::uint64_t(1) << 52) - 1);
+    int const biased_exponent = int(bits >> 52) & 0x7FF;
+    if (biased_exponent == 0x7FF) {
+        return std::uint16_t(sign | infinity | (mantissa != 0 ? (1u << (MantissaBits - 1)) | std::uint32_t(mantissa >> (52 - MantissaBits)) : 0u));
+    }
+    int const exponent = biased_exponent - 1023;
+    if (biased_exponent == 0 || exponent < -bias - MantissaBits - 1) {
+        return std::uint16_t(sign);
+    }
+    if (exponent > bias) {
+        return std::uint16_t(sign | infinity);
+    }
+    // Values below the smallest normal are shifted further, into the subnormal encoding.
+    std::uint64_t const significand = mantissa | (std::uint64_t(1) << 52);
+    int const shift = 52 - MantissaBits + (exponent < 1 - bias ? 1 - bias - exponent : 0);
+    std::uint64_t rounded = significand >> shift;
+    std::uint64_t const remainder = significand & ((std::uint64_t(1) << shift) - 1);
+    std::uint64_t const halfway = std::uint64_t(1) << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (rounded & 1u) != 0)) {
+        ++rounded;
+    }
+    // The implicit bit in rounded adds one to the exponent field, and a carry out of the mantissa moves it up.
+    std::uint32_t const result = exponent < 1 - bias
+        ? std::uint32_t(rounded)
+        : (std::uint32_t(exponent + bias - 1) << MantissaBits) + std::uint32_t(rounded);
+    return std::uint16_t(sign | (result < infinity ? result : infinity));
+}
+
+inline std::uint16_t to_half_bits(float value) noexcept { return float_to_half_bits(value); }
+inline std::uint16_t to_half_bits(double value) noexcept { return double_to_narrow_bits<5, 10>(value); }
+inline std::uint16_t to_bfloat16_bits(float value) noexcept { return float_to_bfloat16_bits(value); }
+inline std::uint16_t to_bfloat16_bits(double value) noexcept { return double_to_narrow_bits<8, 7>(value); }
+
+}  // namespace detail
+
+// IEEE 754 binary16 storage. It promotes to primitive<float> and wider; narrowing into it only happens through from.
+class half final {
+    std::uint16_t m_bits;
+
+public:
+    constexpr half() noexcept : m_bits() {}
+
+    template<typename U, typename = std::enable_if_t< is_conversion<U, half>::value >>
+    static half from(U const& value) noexcept {
+        return from_bits(detail::to_half_bits(value));
+    }
+
+    template<typename U, typename = std::enable_if_t< is_conversion<U, half>::value >>
+    static half from(primitive<U> const& value) noexcept {
+        return from(value.get());
+    }
+
+    static constexpr half from_bits(std::uint16_t bits) noexcept {
+        half result;
+        result.m_bits = bits;
+        return result;
+    }
+
+    constexpr std::uint16_t bits() const noexcept { return m_bits; }
+
+    primitive<float> get() const noexcept {
+        return primitive<float>(detail::half_bits_to_float(m_bits));
+    }
+
+    template<typename U, typename = std::enable_if_t< is_promotion<half, U>::value >>
+    explicit operator U() const noexcept {
+        return U(detail::half_bits_to_float(m_bits));
+    }
+};
+
+// bfloat16 storage: the upper half of a float. It promotes to primitive<float> and wider; narrowing into it only happens through from.
+class bfloat16 final {
+    std::uint16_t m_bits;
+
+public:
+    constexpr bfloat16() noexcept : m_bits() {}
+
+    template<typename U, typename = std::enable_if_t< is_conversion<U, bfloat16>::value >>
+    static bfloat16 from(U const& value) noexcept {
+        return from_bits(detail::to_bfloat16_bits(value));
+    }
+
+    template<typename U, typename = std::enable_if_t< is_conversion<U, bfloat16>::value >>
+    static bfloat16 from(primitive<U> const& value) noexcept {
+        return from(value.get());
+    }
+
+    static constexpr bfloat16 from_bits(std::uint16_t bits) noexcept {
+        bfloat16 result;
+        result.m_bits = bits;
+        return result;
+    }
+
+    constexpr std::uint16_t bits() const noexcept { return m_bits; }
+
+    primitive<float> get() const noexcept {
+        return primitive<float>(detail::bfloat16_bits_to_float(m_bits));
+    }
+
+    template<typename U, typename = std::enable_if_t< is_promotion<bfloat16, U>::value >>
+    explicit operator U() const noexcept {
+        return U(detail::bfloat16_bits_to_float(m_bits));
+    }
+};
+
+// Widens count half values into floats, eight or sixteen at a time with F16C or AVX-512 when the compiler targets them.
+inline primitive<float>* convert(half const* source, std::size_t count, primitive<float>* destination) noexcept {
+    std::size_t index = 0;
+#if defined(__AVX512F__)
+    for (; index + 16 <= count; index += 16) {
+        __m256i const packed = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + index));
+        _mm512_storeu_ps(reinterpret_cast<float*>(destination + index), _mm512_cvtph_ps(packed));
+    }
+#endif
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+    for (; index + 8 <= count; index += 8) {
+        __m128i const packed = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + index));
+        _mm256_storeu_ps(reinterpret_cast<float*>(destination + index), _mm256_cvtph_ps(packed));
+    }
+#endif
+    for (; index < count; ++index) {
+        destination[index] = source[index].get();
+    }
+    return destination + count;
+}
+
+// Narrows count floats into half values with round-to-nearest-even, using F16C or AVX-512 when the compiler targets them.
+inline half* convert(primitive<float> const* source, std::size_t count, half* destination) noexcept {
+    std::size_t index = 0;
+#if defined(__AVX512F__)
+    for (; index + 16 <= count; index += 16) {
+        __m512 const values = _mm512_loadu_ps(reinterpret_cast<float const*>(source + index));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + index), _mm512_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+    for (; index + 8 <= count; index += 8) {
+        __m256 const values = _mm256_loadu_ps(reinterpret_cast<float const*>(source + index));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for (; index < count; ++index) {
+        destination[index] = half::from(source[index]);
+    }
+    return destination + count;
+}
+
+// bfloat16 conversions are plain integer shifts and adds, which compilers vectorize without special instructions.
+inline primitive<float>* convert(bfloat16 const* source, std::size_t count, primitive<float>* destination) noexcept {
+    for (std::size_t index = 0; index != count; ++index) {
+        destination[index] = detail::bfloat16_bits_to_float(source[index].bits());
+    }
+    return destination + count;
+}
+
+inline bfloat16* convert(primitive<float> const* source, std::size_t count, bfloat16* destination) noexcept {
+    for (std::size_t index = 0; index != count; ++index) {
+        destination[index] = bfloat16::from(source[index]);
+    }
+    return destination + count;
+}
+
+}  // namespace primitives
+
+#endif
@@ -0,0 +1,388 @@
+#ifndef INVARIANT_DIVISOR_HPP
+#define INVARIANT_DIVISOR_HPP
+
+#include "primitive.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace primitives {
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+// __extension__ keeps -Wpedantic from flagging the compiler's 128-bit integers.
+__extension__ typedef unsigned __int128 uint128;
+__extension__ typedef __int128 int128;
+#endif
+
+template<typename U>
+constexpr U multiply_high(U lhs, U rhs) noexcept {
+    static_assert(std::is_unsigned<U>::value, "multiply_high requires an unsigned type.");
+    constexpr int bits = std::numeric_limits<U>::digits;
+    static_assert(bits <= 64, "multiply_high supports at most 64 bits.");
+#if defined(__SIZEOF_INT128__)
+    return bits <= 32
+        ? U((std::uint64_t(lhs) * std::uint64_t(rhs)) >> (bits % 64))
+        : U((static_cast<uint128>(lhs) * rhs) >> (bits % 128));
+#else
+    if (bits <= 32) {
+        return U((std::uint64_t(lhs) * std::uint64_t(rhs)) >> (bits % 64));
+    }
+    std::uint64_t const a = std::uint64_t(lhs);
+    std::uint64_t const b = std::uint64_t(rhs);
+    std::uint64_t const a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    std::uint64_t const b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    std::uint64_t const lo_lo = a_lo * b_lo;
+    std::uint64_t const hi_lo = a_hi * b_lo;
+    std::uint64_t const lo_hi = a_lo * b_hi;
+    std::uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    return U(a_hi * b_hi + (hi_lo >> 32) + (cross >> 32));
+#endif
+}
+
+template<typename S>
+constexpr S multiply_high_signed(S lhs, S rhs) noexcept {
+    static_assert(std::is_signed<S>::value, "multiply_high_signed requires a signed type.");
+    constexpr int bits = std::numeric_limits<S>::digits + 1;
+    static_assert(bits <= 64, "multiply_high_signed supports at most 64 bits.");
+#if defined(__SIZEOF_INT128__)
+    return bits <= 32
+        ? S((std::int64_t(lhs) * std::int64_t(rhs)) >> (bits % 64))
+        : S((static_cast<int128>(lhs) * rhs) >> (bits % 128));
+#else
+    if (bits <= 32) {
+        return S((std::int64_t(lhs) * std::int64_t(rhs)) >> (bits % 64));
+    }
+    // The signed high word is the unsigned high word corrected for each negative operand.
+    using U = std::make_unsigned_t<S>;
+    U const high = multiply_high<U>(U(lhs), U(rhs))
+        - (lhs < 0 ? U(rhs) : U(0))
+        - (rhs < 0 ? U(lhs) : U(0));
+    return S(high);
+#endif
+}
+
+// Divides the double-width value (high:low) by divisor; high must be less than divisor.
+template<typename U>
+constexpr U divide_wide(U high, U low, U divisor) noexcept {
+    constexpr int bits = std::numeric_limits<U>::digits;
+    for (int i = 0; i != bits; ++i) {
+        bool const carry = (high >> (bits - 1)) != 0;
+        high = U(U(high << 1) | U(low >> (bits - 1)));
+        low = U(low << 1);
+        if (carry || high >= divisor) {
+            high = U(high - divisor);
+            low = U(low | 1u);
+        }
+    }
+    return low;
+}
+
+template<typename U>
+constexpr int ceil_log2(U value) noexcept {
+    constexpr int bits = std::numeric_limits<U>::digits;
+    int result = 0;
+    while (result < bits && (U(1) << result) < value) {
+        ++result;
+    }
+    return result;
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+// The high halves of four unsigned 32-bit products; SSE2 multiplies the even and odd lanes separately.
+inline __m128i multiply_high_epu32(__m128i lhs, __m128i rhs) noexcept {
+    __m128i const even = _mm_srli_epi64(_mm_mul_epu32(lhs, rhs), 32);
+    __m128i const odd = _mm_mul_epu32(_mm_srli_epi64(lhs, 32), _mm_srli_epi64(rhs, 32));
+    return _mm_or_si128(even, _mm_and_si128(odd, _mm_set_epi32(-1, 0, -1, 0)));
+}
+
+// The signed high half is the unsigned one minus each operand where the other is negative, as in multiply_high_signed.
+inline __m128i multiply_high_epi32(__m128i lhs, __m128i rhs) noexcept {
+    __m128i const high = multiply_high_epu32(lhs, rhs);
+    __m128i const corrections = _mm_add_epi32(
+        _mm_and_si128(_mm_srai_epi32(lhs, 31), rhs), _mm_and_si128(_mm_srai_epi32(rhs, 31), lhs));
+    return _mm_sub_epi32(high, corrections);
+}
+
+inline __m128i multiply_low_epi32(__m128i lhs, __m128i rhs) noexcept {
+#if defined(__SSE4_1__)
+    return _mm_mullo_epi32(lhs, rhs);
+#else
+    __m128i const even = _mm_mul_epu32(lhs, rhs);
+    __m128i const odd = _mm_mul_epu32(_mm_srli_epi64(lhs, 32), _mm_srli_epi64(rhs, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, 0x08), _mm_shuffle_epi32(odd, 0x08));
+#endif
+}
+#endif
+
+#if defined(__AVX2__)
+inline __m256i multiply_high_epu32(__m256i lhs, __m256i rhs) noexcept {
+    __m256i const even = _mm256_srli_epi64(_mm256_mul_epu32(lhs, rhs), 32);
+    __m256i const odd = _mm256_mul_epu32(_mm256_srli_epi64(lhs, 32), _mm256_srli_epi64(rhs, 32));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+inline __m256i multiply_high_epi32(__m256i lhs, __m256i rhs) noexcept {
+    __m256i const even = _mm256_srli_epi64(_mm256_mul_epi32(lhs, rhs), 32);
+    __m256i const odd = _mm256_mul_epi32(_mm256_srli_epi64(lhs, 32), _mm256_srli_epi64(rhs, 32));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+#endif
+
+// Granlund and Montgomery, "Division by Invariant Integers using Multiplication", figure 4.1.
+template<typename T, bool = std::is_signed<T>::value>
+class divisor_magic {
+    using U = std::make_unsigned_t<T>;
+
+    U m_multiplier;
+    unsigned char m_pre_shift;
+    unsigned char m_post_shift;
+
+    static constexpr U multiplier(U divisor, int log) noexcept {
+        constexpr int bits = std::numeric_limits<U>::digits;
+        U const high = log == bits ? U(U(0) - divisor) : U(U(U(1) << log) - divisor);
+        return U(divide_wide<U>(high, U(0), divisor) + 1u);
+    }
+
+public:
+    constexpr explicit divisor_magic(T divisor) noexcept
+        : m_multiplier(multiplier(divisor, ceil_log2<U>(divisor))),
+          m_pre_shift(ceil_log2<U>(divisor) == 0 ? 0 : 1),
+          m_post_shift(ceil_log2<U>(divisor) == 0 ? 0 : ceil_log2<U>(divisor) - 1) {}
+
+    constexpr T divide(T numerator) const noexcept {
+        U const high = multiply_high<U>(m_multiplier, U(numerator));
+        return T(U(high + U(U(U(numerator) - high) >> m_pre_shift)) >> m_post_shift);
+    }
+
+    // The same steps on four or eight 32-bit lanes.
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128i divide(__m128i numerators) const noexcept {
+        __m128i const high = multiply_high_epu32(numerators, _mm_set1_epi32(int(m_multiplier)));
+        __m128i const sum = _mm_add_epi32(high, _mm_srl_epi32(_mm_sub_epi32(numerators, high), _mm_cvtsi32_si128(m_pre_shift)));
+        return _mm_srl_epi32(sum, _mm_cvtsi32_si128(m_post_shift));
+    }
+#endif
+#if defined(__AVX2__)
+    __m256i divide(__m256i numerators) const noexcept {
+        __m256i const high = multiply_high_epu32(numerators, _mm256_set1_epi32(int(m_multiplier)));
+        __m256i const sum = _mm256_add_epi32(high, _mm256_srl_epi32(_mm256_sub_epi32(numerators, high), _mm_cvtsi32_si128(m_pre_shift)));
+        return _mm256_srl_epi32(sum, _mm_cvtsi32_si128(m_post_shift));
+    }
+#endif
+};
+
+// Granlund and Montgomery, "Division by Invariant Integers using Multiplication", figure 5.2.
+template<typename T>
+class divisor_magic<T, true> {
+    using U = std::make_unsigned_t<T>;
+
+    T m_multiplier;
+    T m_sign;
+    unsigned char m_shift;
+
+    static constexpr U magnitude(T divisor) noexcept {
+        return divisor < 0 ? U(U(0) - U(divisor)) : U(divisor);
+    }
+    static constexpr int log(T divisor) noexcept {
+        return ceil_log2<U>(magnitude(divisor)) < 1 ? 1 : ceil_log2<U>(magnitude(divisor));
+    }
+    static constexpr T multiplier(T divisor) noexcept {
+        // For |divisor| == 1 the quotient would not fit; its wrapped multiplier is 1.
+        return magnitude(divisor) == 1
+            ? T(1)
+            : T(U(divide_wide<U>(U(U(1) << (log(divisor) - 1)), U(0), magnitude(divisor)) + 1u));
+    }
+
+public:
+    constexpr explicit divisor_magic(T divisor) noexcept
+        : m_multiplier(multiplier(divisor)),
+          m_sign(divisor < 0 ? T(-1) : T(0)),
+          m_shift(log(divisor) - 1) {}
+
+    constexpr T divide(T numerator) const noexcept {
+        T const n_sign = T(numerator >> (std::numeric_limits<T>::digits));
+        T const high = T(U(U(numerator) + U(multiply_high_signed<T>(m_multiplier, numerator))));
+        T const quotient = T(U(U(T(high >> m_shift)) - U(n_sign)));
+        return T(U(U(T(quotient ^ m_sign)) - U(m_sign)));
+    }
+
+    // The same steps on four or eight 32-bit lanes.
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128i divide(__m128i numerators) const noexcept {
+        __m128i const high = _mm_add_epi32(numerators, multiply_high_epi32(_mm_set1_epi32(int(m_multiplier)), numerators));
+        __m128i const quotients = _mm_sub_epi32(_mm_sra_epi32(high, _mm_cvtsi32_si128(m_shift)), _mm_srai_epi32(numerators, 31));
+        __m128i const sign = _mm_set1_epi32(int(m_sign));
+        return _mm_sub_epi32(_mm_xor_si128(quotients, sign), sign);
+    }
+#endif
+#if defined(__AVX2__)
+    __m256i divide(__m256i numerators) const noexcept {
+        __m256i const high = _mm256_add_epi32(numerators, multiply_high_epi32(_mm256_set1_epi32(int(m_multiplier)), numerators));
+        __m256i const quotients = _mm256_sub_epi32(_mm256_sra_epi32(high, _mm_cvtsi32_si128(m_shift)), _mm256_srai_epi32(numerators, 31));
+        __m256i const sign = _mm256_set1_epi32(int(m_sign));
+        return _mm256_sub_epi32(_mm256_xor_si256(quotients, sign), sign);
+    }
+#endif
+};
+
+// Divides (or takes remainders of) as many leading values as fill whole vectors and returns how many that was.
+template<bool Remainder, typename T>
+std::size_t divide_vectors(divisor_magic<T> const&, T, primitive<T> const*, std::size_t, primitive<T>*, std::false_type) noexcept {
+    return 0;
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+template<bool Remainder, typename T>
+std::size_t divide_vectors(divisor_magic<T> const& magic, T divisor, primitive<T> const* source, std::size_t count, primitive<T>* destination, std::true_type) noexcept {
+    std::size_t index = 0;
+#if defined(__AVX2__)
+    __m256i const wide_divisors = _mm256_set1_epi32(int(divisor));
+    for (; index != count - count % 8; index += 8) {
+        __m256i const numerators = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + index));
+        __m256i const quotients = magic.divide(numerators);
+        __m256i const results = Remainder ? _mm256_sub_epi32(numerators, _mm256_mullo_epi32(quotients, wide_divisors)) : quotients;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + index), results);
+    }
+#endif
+    __m128i const divisors = _mm_set1_epi32(int(divisor));
+    for (; index != count - count % 4; index += 4) {
+        __m128i const numerators = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + index));
+        __m128i const quotients = magic.divide(numerators);
+        __m128i const results = Remainder ? _mm_sub_epi32(numerators, multiply_low_epi32(quotients, divisors)) : quotients;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), results);
+    }
+    return index;
+}
+
+template<typename T>
+using is_vector_divisor = std::integral_constant<bool, sizeof(T) == 4>;
+#else
+template<typename T>
+using is_vector_divisor = std::false_type;
+#endif
+
+// Contiguous ranges of primitive<T> take the vector path.
+template<typename InputIt, typename OutputIt, typename T>
+using is_contiguous_division = std::integral_constant<bool,
+    std::is_pointer<InputIt>::value && std::is_pointer<OutputIt>::value
+    && std::is_same<std::remove_cv_t<std::remove_pointer_t<InputIt>>, primitive<T>>::value
+    && std::is_same<std::remove_pointer_t<OutputIt>, primitive<T>>::value>;
+
+}  // namespace detail
+
+// Precomputes a multiply-shift reciprocal so repeated division by the same runtime value avoids a hardware divide.
+template<typename T, typename = std::enable_if_t< std::is_integral<T>::value && !std::is_same<T, bool>::value >>
+class invariant_divisor final {
+    T m_divisor;
+    detail::divisor_magic<T> m_magic;
+
+public:
+    using value_type = T;
+
+    // The divisor must not be zero.
+    constexpr explicit invariant_divisor(primitive<T> const& divisor) noexcept
+        : m_divisor(divisor.get()), m_magic(divisor.get()) {}
+
+    constexpr primitive<T> divisor() const noexcept { return primitive<T>(m_divisor); }
+
+    constexpr primitive<T> divide(primitive<T> const& numerator) const noexcept {
+        return primitive<T>(m_magic.divide(numerator.get()));
+    }
+
+    constexpr primitive<T> remainder(primitive<T> const& numerator) const noexcept {
+        using U = std::make_unsigned_t<T>;
+        T const quotient = m_magic.divide(numerator.get());
+        return primitive<T>(T(U(U(numerator.get()) - U(U(quotient) * U(m_divisor)))));
+    }
+
+    // Divides count values, eight or four at a time with AVX2 or SSE2 for 32-bit types. The ranges may be the same.
+    primitive<T>* divide(primitive<T> const* source, std::size_t count, primitive<T>* destination) const noexcept {
+        std::size_t index = detail::divide_vectors<false>(m_magic, m_divisor, source, count, destination, detail::is_vector_divisor<T>());
+        for (; index < count; ++index) {
+            destination[index] = divide(source[index]);
+        }
+        return destination + count;
+    }
+
+    primitive<T>* remainder(primitive<T> const* source, std::size_t count, primitive<T>* destination) const noexcept {
+        std::size_t index = detail::divide_vectors<true>(m_magic, m_divisor, source, count, destination, detail::is_vector_divisor<T>());
+        for (; index < count; ++index) {
+            destination[index] = remainder(source[index]);
+        }
+        return destination + count;
+    }
+};
+
+template<typename T>
+constexpr primitive<T> operator/(primitive<T> const& lhs, invariant_divisor<T> const& rhs) noexcept {
+    return rhs.divide(lhs);
+}
+
+template<typename T>
+constexpr primitive<T> operator%(primitive<T> const& lhs, invariant_divisor<T> const& rhs) noexcept {
+    return rhs.remainder(lhs);
+}
+
+template<typename T>
+primitive<T>& operator/=(primitive<T> & lhs, invariant_divisor<T> const& rhs) noexcept {
+    return lhs = rhs.divide(lhs);
+}
+
+template<typename T>
+primitive<T>& operator%=(primitive<T> & lhs, invariant_divisor<T> const& rhs) noexcept {
+    return lhs = rhs.remainder(lhs);
+}
+
+namespace detail {
+
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt divide(InputIt first, InputIt last, OutputIt destination, invariant_divisor<T> const& divisor, std::true_type) noexcept {
+    return divisor.divide(first, std::size_t(last - first), destination);
+}
+
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt divide(InputIt first, InputIt last, OutputIt destination, invariant_divisor<T> const& divisor, std::false_type) noexcept {
+    for (; first != last; ++first, ++destination) {
+        *destination = divisor.divide(*first);
+    }
+    return destination;
+}
+
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt remainder(InputIt first, InputIt last, OutputIt destination, invariant_divisor<T> const& divisor, std::true_type) noexcept {
+    return divisor.remainder(first, std::size_t(last - first), destination);
+}
+
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt remainder(InputIt first, InputIt last, OutputIt destination, invariant_divisor<T> const& divisor, std::false_type) noexcept {
+    for (; first != last; ++first, ++destination) {
+        *destination = divisor.remainder(*first);
+    }
+    return destination;
+}
+
+}  // namespace detail
+
+// Applies the divisor across a range. Pointer ranges of primitive<T> use the batch members, which divide 32-bit
+// values in SSE2 or AVX2 registers; other ranges run the scalar multiply-shift per element.
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt divide(InputIt first, InputIt last, OutputIt destination, invariant_divisor<T> const& divisor) noexcept {
+    return detail::divide(first, last, destination, divisor, detail::is_contiguous_division<InputIt, OutputIt, T>());
+}
+
+template<typename InputIt, typename OutputIt, typename T>
+OutputIt remainder(InputIt first, InputIt last, OutputIt destination, invariant_divisor<T> const& divisor) noexcept {
+    return detail::remainder(first, last, destination, divisor, detail::is_contiguous_division<InputIt, OutputIt, T>());
+}
+
+}  // namespace primitives
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef PRIMITIVE_COUNTER_HPP
+#define PRIMITIVE_COUNTER_HPP
+
+#include "primitive.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace primitives {
+
+// The line size of current x86 and most ARM cores; std::hardware_destructive_interference_size is C++17 and often missing.
+constexpr std::size_t cache_line_size = 64;
+
+// A primitive alone on its cache line, so that values written by different threads never share one.
+template<typename T>
+class alignas(cache_line_size) padded_primitive final {
+    primitive<T> m_value;
+
+public:
+    using value_type = T;
+
+    constexpr padded_primitive() noexcept : m_value() {}
+
+    template<typename U, typename = std::enable_if_t<
+         std::is_same<T, U>::value || is_promotion<U, T>::value
+    >>
+    constexpr padded_primitive(U const& value) noexcept : m_value(value) {}
+
+    template<typename U, typename = std::enable_if_t< std::is_same<T, U>::value || is_promotion<U, T>::value >>
+    constexpr padded_primitive(primitive<U> const& value) noexcept : m_value(value) {}
+
+    primitive<T>& get() noexcept { return m_value; }
+    constexpr primitive<T> const& get() const noexcept { return m_value; }
+};
+
+namespace detail {
+
+template<typename T>
+struct alignas(cache_line_size) counter_shard {
+    std::atomic<T> value;
+
+    counter_shard() noexcept : value(T()) {}
+};
+
+// Numbers threads in the order they first touch any counter; consecutive threads get different shards.
+// The slot is constant-initialized and assigned on first use, which avoids a thread_local initialization guard.
+inline std::size_t thread_slot() noexcept {
+    static std::atomic<std::size_t> next_slot(1);
+    thread_local std::size_t slot = 0;
+    if (slot == 0) {
+        slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    }
+    return slot;
+}
+
+inline std::size_t round_up_power_of_two(std::size_t value) noexcept {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Two shards per hardware thread keep collisions rare when there are more threads than cores.
+inline std::size_t default_shard_count() noexcept {
+    return round_up_power_of_two(2 * std::max(1u, std::thread::hardware_concurrency()));
+}
+
+}  // namespace detail
+
+// A counter for statistics incremented from many threads. Each thread adds to its own cache-line-sized shard,
+// so increments do not contend; reading the total sums all shards with relaxed loads, which is only exact once
+// the writers have stopped.
+template<typename T, typename = std::enable_if_t< std::is_integral<T>::value && !std::is_same<T, bool>::value >>
+class primitive_counter final {
+    using shard = detail::counter_shard<T>;
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    std::size_t m_mask;
+    std::unique_ptr<unsigned char[]> m_storage;
+    shard* m_shards;
+
+    shard& local_shard() noexcept {
+        return m_shards[detail::thread_slot() & m_mask];
+    }
+
+public:
+    using value_type = T;
+
+    explicit primitive_counter(std::size_t shard_count = detail::default_shard_count())
+        : m_mask(detail::round_up_power_of_two(std::max(std::size_t(1), shard_count)) - 1),
+          m_storage(new unsigned char[(m_mask + 1) * sizeof(shard) + cache_line_size]),
+          m_shards(reinterpret_cast<shard*>(m_storage.get() + (cache_line_size - reinterpret_cast<std::uintptr_t>(m_storage.get()) % cache_line_size) % cache_line_size)) {
+        for (std::size_t index = 0; index <= m_mask; ++index) {
+            new (m_shards + index) shard();
+        }
+    }
+
+    primitive_counter(primitive_counter const&) = delete;
+    primitive_counter& operator=(primitive_counter const&) = delete;
+
+    std::size_t shard_count() const noexcept { return m_mask + 1; }
+
+    void add(primitive<T> const& amount) noexcept {
+        local_shard().value.fetch_add(amount.get(), std::memory_order_relaxed);
+    }
+
+    void subtract(primitive<T> const& amount) noexcept {
+        local_shard().value.fetch_sub(amount.get(), std::memory_order_relaxed);
+    }
+
+    primitive_counter& operator+=(primitive<T> const& amount) noexcept {
+        add(amount);
+        return *this;
+    }
+
+    primitive_counter& operator-=(primitive<T> const& amount) noexcept {
+        subtract(amount);
+        return *this;
+    }
+
+    primitive_counter& operator++() noexcept {
+        add(T(1));
+        return *this;
+    }
+
+    primitive_counter& operator--() noexcept {
+        subtract(T(1));
+        return *this;
+    }
+
+    // Shards wrap independently, so the sum is taken modulo 2^N like a single counter would be.
+    primitive<T> get() const noexcept {
+        unsigned_type total = 0;
+        for (std::size_t index = 0; index <= m_mask; ++index) {
+            total = unsigned_type(total + unsigned_type(m_shards[index].value.load(std::memory_order_relaxed)));
+        }
+        return primitive<T>(T(total));
+    }
+
+    // Increments racing with a reset may be kept or lost.
+    void reset() noexcept {
+        for (std::size_t index = 0; index <= m_mask; ++index) {
+            m_shards[index].value.store(T(), std::memory_order_relaxed);
+        }
+    }
+};
+
+}  // namespace primitives
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef SCAN_HPP
+#define SCAN_HPP
+
+#include "primitive.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace primitives {
+
+struct scan_plus {
+    template<typename T>
+    constexpr T operator()(T const& lhs, T const& rhs) const noexcept { return T(lhs + rhs); }
+    template<typename T>
+    static constexpr T identity() noexcept { return T(); }
+};
+
+struct scan_max {
+    template<typename T>
+    constexpr T operator()(T const& lhs, T const& rhs) const noexcept { return lhs < rhs ? rhs : lhs; }
+    template<typename T>
+    static constexpr T identity() noexcept { return std::numeric_limits<T>::lowest(); }
+};
+
+struct scan_min {
+    template<typename T>
+    constexpr T operator()(T const& lhs, T const& rhs) const noexcept { return rhs < lhs ? rhs : lhs; }
+    template<typename T>
+    static constexpr T identity() noexcept { return std::numeric_limits<T>::max(); }
+};
+
+struct scan_xor {
+    template<typename T, typename = std::enable_if_t< std::is_integral<T>::value >>
+    constexpr T operator()(T const& lhs, T const& rhs) const noexcept { return T(lhs ^ rhs); }
+    template<typename T>
+    static constexpr T identity() noexcept { return T(); }
+};
+
+namespace detail {
+
+// Inputs at least this long are scanned in blocks across hardware threads.
+constexpr std::size_t parallel_scan_threshold = std::size_t(1) << 20;
+
+#if defined(__SSE2__) || defined(_M_X64)
+template<typename Op, typename T> struct vector_scan_op { static constexpr bool enabled = false; };
+
+template<typename T> struct vector_scan_op<scan_plus, T> {
+    static constexpr bool enabled = std::is_integral<T>::value && sizeof(T) == 4;
+    static __m128i apply(__m128i lhs, __m128i rhs) noexcept { return _mm_add_epi32(lhs, rhs); }
+};
+
+template<typename T> struct vector_scan_op<scan_xor, T> {
+    static constexpr bool enabled = std::is_integral<T>::value && sizeof(T) == 4;
+    static __m128i apply(__m128i lhs, __m128i rhs) noexcept { return _mm_xor_si128(lhs, rhs); }
+};
+
+// Doubles take two lanes. The serial max and min keep their left operand when either is NaN, so a NaN input is
+// skipped while a NaN carry sticks; the lanes match that by reading NaN inputs as the infinity that never wins and
+// by swapping the operands so that a NaN or a pair of signed zeros resolves to the left one.
+inline __m128d replace_nan(__m128d values, double replacement) noexcept {
+    __m128d const nan = _mm_cmpunord_pd(values, values);
+    return _mm_or_pd(_mm_andnot_pd(nan, values), _mm_and_pd(nan, _mm_set1_pd(replacement)));
+}
+
+template<> struct vector_scan_op<scan_plus, double> {
+    static constexpr bool enabled = true;
+    static __m128d prepare(__m128d values) noexcept { return values; }
+    static __m128d apply(__m128d lhs, __m128d rhs) noexcept { return _mm_add_pd(lhs, rhs); }
+};
+
+template<> struct vector_scan_op<scan_max, double> {
+    static constexpr bool enabled = true;
+    static __m128d prepare(__m128d values) noexcept { return replace_nan(values, -std::numeric_limits<double>::infinity()); }
+    static __m128d apply(__m128d lhs, __m128d rhs) noexcept { return _mm_max_pd(rhs, lhs); }
+};
+
+template<> struct vector_scan_op<scan_min, double> {
+    static constexpr bool enabled = true;
+    static __m128d prepare(__m128d values) noexcept { return replace_nan(values, std::numeric_limits<double>::infinity()); }
+    static __m128d apply(__m128d lhs, __m128d rhs) noexcept { return _mm_min_pd(rhs, lhs); }
+};
+
+#if defined(__SSE4_1__)
+template<typename T> struct vector_scan_op<scan_max, T> {
+    static constexpr bool enabled = std::is_integral<T>::value && sizeof(T) == 4;
+    static __m128i apply(__m128i lhs, __m128i rhs) noexcept {
+        return std::is_signed<T>::value ? _mm_max_epi32(lhs, rhs) : _mm_max_epu32(lhs, rhs);
+    }
+};
+
+template<typename T> struct vector_scan_op<scan_min, T> {
+    static constexpr bool enabled = std::is_integral<T>::value && sizeof(T) == 4;
+    static __m128i apply(__m128i lhs, __m128i rhs) noexcept {
+        return std::is_signed<T>::value ? _mm_min_epi32(lhs, rhs) : _mm_min_epu32(lhs, rhs);
+    }
+};
+#endif
+
+// Prefix scans four 32-bit lanes in register (log2 shift-and-combine), carrying the running total across vectors.
+template<typename Op, typename T>
+T vector_scan_block(primitive<T> const* source, std::size_t count, primitive<T>* destination, T carry, bool inclusive) noexcept {
+    using vector_op = vector_scan_op<Op, T>;
+    __m128i const identity = _mm_set1_epi32(int(Op::template identity<T>()));
+    __m128i const identity_one = _mm_srli_si128(identity, 12);
+    __m128i const identity_two = _mm_srli_si128(identity, 8);
+    __m128i const lane_zero = _mm_srli_si128(_mm_set1_epi32(-1), 12);
+    __m128i running = _mm_set1_epi32(int(carry));
+    std::size_t const vector_count = count - count % 4;
+    for (std::size_t index = 0; index != vector_count; index += 4) {
+        __m128i const values = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + index));
+        __m128i const shifted = _mm_or_si128(_mm_slli_si128(values, 4), identity_one);
+        __m128i prefix = vector_op::apply(values, shifted);
+        prefix = vector_op::apply(prefix, _mm_or_si128(_mm_slli_si128(prefix, 8), identity_two));
+        __m128i const result = vector_op::apply(prefix, running);
+        if (inclusive) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), result);
+        } else {
+            __m128i const previous = _mm_or_si128(_mm_slli_si128(result, 4), _mm_and_si128(running, lane_zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), previous);
+        }
+        running = _mm_shuffle_epi32(result, 0xFF);
+    }
+    carry = T(_mm_cvtsi128_si32(running));
+    Op op;
+    for (std::size_t index = vector_count; index != count; ++index) {
+        T const value = source[index].get();
+        T const next = op(carry, value);
+        destination[index] = inclusive ? next : carry;
+        carry = next;
+    }
+    return carry;
+}
+
+// Prefix scans two double lanes, keeping the earlier value on the left of each combination like the serial loop.
+template<typename Op>
+double vector_scan_block(primitive<double> const* source, std::size_t count, primitive<double>* destination, double carry, bool inclusive) noexcept {
+    using vector_op = vector_scan_op<Op, double>;
+    __m128d running = _mm_set1_pd(carry);
+    std::size_t const vector_count = count - count % 2;
+    for (std::size_t index = 0; index != vector_count; index += 2) {
+        __m128d const values = vector_op::prepare(_mm_loadu_pd(reinterpret_cast<double const*>(source + index)));
+        __m128d const prefix = _mm_move_sd(vector_op::apply(_mm_unpacklo_pd(values, values), values), values);
+        __m128d const result = vector_op::apply(running, prefix);
+        _mm_storeu_pd(reinterpret_cast<double*>(destination + index), inclusive ? result : _mm_unpacklo_pd(running, result));
+        running = _mm_unpackhi_pd(result, result);
+    }
+    carry = _mm_cvtsd_f64(running);
+    Op op;
+    for (std::size_t index = vector_count; index != count; ++index) {
+        double const next = op(carry, source[index].get());
+        destination[index] = inclusive ? next : carry;
+        carry = next;
+    }
+    return carry;
+}
+
+template<typename Op, typename T, typename TAcc>
+constexpr bool is_vector_scan() noexcept {
+    return std::is_same<T, TAcc>::value && vector_scan_op<Op, T>::enabled;
+}
+
+template<typename T, typename Op>
+T scan_block(primitive<T> const* source, std::size_t count, primitive<T>* destination, T carry, Op, bool inclusive, std::true_type) noexcept {
+    return vector_scan_block<Op>(source, count, destination, carry, inclusive);
+}
+#else
+template<typename Op, typename T, typename TAcc>
+constexpr bool is_vector_scan() noexcept {
+    return false;
+}
+#endif
+
+template<typename T, typename TAcc, typename Op>
+TAcc scan_block(primitive<T> const* source, std::size_t count, primitive<TAcc>* destination, TAcc carry, Op op, bool inclusive, std::false_type) {
+    for (std::size_t index = 0; index != count; ++index) {
+        TAcc const value = source[index].get();
+        TAcc const next = TAcc(op(carry, value));
+        destination[index] = inclusive ? next : carry;
+        carry = next;
+    }
+    return carry;
+}
+
+// Scans count values starting from carry and returns the combined total.
+template<typename T, typename TAcc, typename Op>
+TAcc scan_block(primitive<T> const* source, std::size_t count, primitive<TAcc>* destination, TAcc carry, Op op, bool inclusive) {
+    using is_vector = std::integral_constant<bool, is_vector_scan<Op, T, TAcc>()>;
+    return scan_block(source, count, destination, carry, op, inclusive, is_vector());
+}
+
+template<typename T, typename TAcc, typename Op>
+TAcc reduce_block(primitive<T> const* source, std::size_t count, TAcc total, Op op) {
+    for (std::size_t index = 0; index != count; ++index) {
+        total = TAcc(op(total, TAcc(source[index].get())));
+    }
+    return total;
+}
+
+// Two passes: each thread reduces its block, the block totals are scanned serially,
+// then each thread scans its block again starting from the preceding blocks' total.
+template<typename T, typename TAcc, typename Op>
+void parallel_scan(primitive<T> const* source, std::size_t count, primitive<TAcc>* destination, TAcc initial, Op op, bool inclusive) {
+    std::size_t const hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t const block_count = std::min(hardware, count / (parallel_scan_threshold / 8));
+    std::size_t const block_size = (count + block_count - 1) / block_count;
+    auto const block_begin = [=](std::size_t block) { return std::min(count, block * block_size); };
+    auto const block_length = [=](std::size_t block) { return block_begin(block + 1) - block_begin(block); };
+
+    // The first block needs no total, so it is scanned while the other blocks are reduced.
+    std::vector<TAcc> totals(block_count);
+    std::vector<std::thread> workers;
+    workers.reserve(block_count);
+    for (std::size_t block = 1; block != block_count; ++block) {
+        workers.emplace_back([=, &totals] {
+            primitive<T> const* first = source + block_begin(block);
+            totals[block] = reduce_block(first + 1, block_length(block) - 1, TAcc(first->get()), op);
+        });
+    }
+    TAcc carry = scan_block(source, block_length(0), destination, initial, op, inclusive);
+    for (auto & worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    for (std::size_t block = 1; block != block_count; ++block) {
+        TAcc const start = carry;
+        carry = TAcc(op(carry, totals[block]));
+        totals[block] = start;
+    }
+    for (std::size_t block = 1; block != block_count; ++block) {
+        workers.emplace_back([=, &totals] {
+            std::size_t const offset = block_begin(block);
+            scan_block(source + offset, block_length(block), destination + offset, totals[block], op, inclusive);
+        });
+    }
+    for (auto & worker : workers) {
+        worker.join();
+    }
+}
+
+}  // namespace detail
+
+// Writes the running combination of the input, including each element, to destination.
+// Accumulation happens in the destination type, which must match or be a promotion of the input type.
+// The operation must be associative; double sums are regrouped in vector lanes and large inputs are scanned on
+// multiple threads, so floating-point results may round differently than a serial loop.
+template<typename T, typename TAcc, typename Op = scan_plus, typename = std::enable_if_t<
+    !std::is_same<TAcc, bool>::value && (std::is_same<T, TAcc>::value || is_promotion<T, TAcc>::value)
+>>
+primitive<TAcc>* inclusive_scan(primitive<T> const* first, primitive<T> const* last, primitive<TAcc>* destination, Op op = Op()) {
+    std::size_t const count = std::size_t(last - first);
+    if (count == 0) {
+        return destination;
+    }
+    TAcc const head = first->get();
+    *destination = head;
+    if (count >= detail::parallel_scan_threshold && std::thread::hardware_concurrency() > 1) {
+        detail::parallel_scan(first + 1, count - 1, destination + 1, head, op, true);
+    } else {
+        detail::scan_block(first + 1, count - 1, destination + 1, head, op, true);
+    }
+    return destination + count;
+}
+
+// Writes the running combination of the input, excluding each element and starting from initial, to destination.
+// Accumulation happens in the destination type, which must match or be a promotion of the input type.
+// The operation must be associative; double sums are regrouped in vector lanes and large inputs are scanned on
+// multiple threads, so floating-point results may round differently than a serial loop.
+template<typename T, typename TAcc, typename Op = scan_plus, typename = std::enable_if_t<
+    !std::is_same<TAcc, bool>::value && (std::is_same<T, TAcc>::value || is_promotion<T, TAcc>::value)
+>>
+primitive<TAcc>* exclusive_scan(primitive<T> const* first, primitive<T> const* last, primitive<TAcc>* destination, primitive<TAcc> const& initial, Op op = Op()) {
+    std::size_t const count = std::size_t(last - first);
+    if (count >= detail::parallel_scan_threshold && std::thread::hardware_concurrency() > 1) {
+        detail::parallel_scan(first, count, destination, initial.get(), op, false);
+    } else {
+        detail::scan_block(first, count, destination, initial.get(), op, false);
+    }
+    return destination + count;
+}
+
+}  // namespace primitives
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef SPARSE_PRIMITIVE_ARRAY_HPP
+#define SPARSE_PRIMITIVE_ARRAY_HPP
+
+#include "primitive.hpp"
+#include "bit.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace primitives {
+
+namespace detail {
+
+// Negative zero is not the default value, so it is stored to keep conversions exact.
+template<typename T>
+bool is_default_value(T const& value, std::true_type) noexcept {
+    return value == T() && !std::signbit(value);
+}
+
+template<typename T>
+bool is_default_value(T const& value, std::false_type) noexcept {
+    return value == T();
+}
+
+template<typename T>
+bool is_default_value(T const& value) noexcept {
+    return is_default_value(value, std::is_floating_point<T>());
+}
+
+}  // namespace detail
+
+// A fixed-size array that stores only the entries that differ from primitive<T>(); every other entry reads as the
+// default. Presence is kept in a bitmap, with the number of stored values before each block of bits, and the
+// stored values are packed in index order.
+template<typename T>
+class sparse_primitive_array final {
+public:
+    // Indices covered by one bitmap word and by one block offset.
+    static constexpr std::size_t word_size = 64;
+    static constexpr std::size_t block_size = 512;
+
+private:
+    static constexpr std::size_t words_per_block = block_size / word_size;
+
+    std::size_t m_size;
+    std::vector<std::uint64_t> m_bits;
+    std::vector<std::size_t> m_block_offsets;
+    std::vector<primitive<T>> m_values;
+
+    // Position in m_values of the entry at index, whether or not it is stored.
+    std::size_t rank(std::size_t index) const noexcept {
+        std::size_t const word = index / word_size;
+        std::size_t position = m_block_offsets[index / block_size];
+        for (std::size_t preceding = word - word % words_per_block; preceding != word; ++preceding) {
+            position += std::size_t(detail::popcount(m_bits[preceding]));
+        }
+        std::uint64_t const below = (std::uint64_t(1) << (index % word_size)) - 1;
+        return position + std::size_t(detail::popcount(m_bits[word] & below));
+    }
+
+    void shift_block_offsets(std::size_t index, bool inserted) noexcept {
+        for (std::size_t block = index / block_size + 1; block != m_block_offsets.size(); ++block) {
+            m_block_offsets[block] = inserted ? m_block_offsets[block] + 1 : m_block_offsets[block] - 1;
+        }
+    }
+
+public:
+    using value_type = T;
+
+    explicit sparse_primitive_array(std::size_t size = 0)
+        : m_size(size),
+          m_bits((size + word_size - 1) / word_size),
+          m_block_offsets((size + block_size - 1) / block_size) {
+    }
+
+    // Builds a sparse array from count dense values, keeping those that differ from the default.
+    static sparse_primitive_array from(primitive<T> const* values, std::size_t count) {
+        sparse_primitive_array result(count);
+        for (std::size_t word = 0; word != result.m_bits.size(); ++word) {
+            if (word % words_per_block == 0) {
+                result.m_block_offsets[word / words_per_block] = result.m_values.size();
+            }
+            std::size_t const first = word * word_size;
+            std::size_t const last = std::min(count, first + word_size);
+            std::uint64_t bits = 0;
+            for (std::size_t index = first; index != last; ++index) {
+                if (!detail::is_default_value(values[index].get())) {
+                    bits |= std::uint64_t(1) << (index - first);
+                    result.m_values.push_back(values[index]);
+                }
+            }
+            result.m_bits[word] = bits;
+        }
+        result.m_values.shrink_to_fit();
+        return result;
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    // The number of stored, non-default entries.
+    std::size_t stored_count() const noexcept { return m_values.size(); }
+
+    // Heap bytes held by the bitmap, block offsets and values.
+    std::size_t memory_usage() const noexcept {
+        return m_bits.capacity() * sizeof(std::uint64_t)
+            + m_block_offsets.capacity() * sizeof(std::size_t)
+            + m_values.capacity() * sizeof(primitive<T>);
+    }
+
+    bool contains(std::size_t index) const noexcept {
+        return (m_bits[index / word_size] >> (index % word_size) & 1u) != 0;
+    }
+
+    primitive<T> operator[](std::size_t index) const noexcept {
+        return contains(index) ? m_values[rank(index)] : primitive<T>();
+    }
+
+    // Stores value at index, or removes the entry if value is the default. Entries after index move, so
+    // filling an array one entry at a time is slow; build it with from where possible.
+    void set(std::size_t index, primitive<T> const& value) {
+        std::size_t const position = rank(index);
+        std::uint64_t const bit = std::uint64_t(1) << (index % word_size);
+        std::uint64_t& word = m_bits[index / word_size];
+        if (detail::is_default_value(value.get())) {
+            if ((word & bit) != 0) {
+                m_values.erase(m_values.begin() + std::ptrdiff_t(position));
+                word &= ~bit;
+                shift_block_offsets(index, false);
+            }
+        } else if ((word & bit) != 0) {
+            m_values[position] = value;
+        } else {
+            m_values.insert(m_values.begin() + std::ptrdiff_t(position), value);
+            word |= bit;
+            shift_block_offsets(index, true);
+        }
+    }
+
+    // Calls action(index, value) for each stored entry in index order, skipping empty words entirely.
+    template<typename TAction>
+    void for_each_stored(TAction action) const {
+        std::size_t position = 0;
+        for (std::size_t word = 0; word != m_bits.size(); ++word) {
+            for (std::uint64_t bits = m_bits[word]; bits != 0; bits &= bits - 1) {
+                action(word * word_size + std::size_t(detail::countr_zero(bits)), m_values[position++]);
+            }
+        }
+    }
+
+    // Returns a copy with each stored value replaced by transform(index, value); entries that become the default
+    // are dropped. Defaults stay defaults, so transform must map them to themselves.
+    template<typename TTransform>
+    sparse_primitive_array transform_stored(TTransform transform) const {
+        sparse_primitive_array result(m_size);
+        result.m_values.reserve(m_values.size());
+        std::size_t position = 0;
+        for (std::size_t word = 0; word != m_bits.size(); ++word) {
+            if (word % words_per_block == 0) {
+                result.m_block_offsets[word / words_per_block] = result.m_values.size();
+            }
+            std::uint64_t kept = 0;
+            for (std::uint64_t bits = m_bits[word]; bits != 0; bits &= bits - 1) {
+                int const bit = detail::countr_zero(bits);
+                primitive<T> const value = transform(word * word_size + std::size_t(bit), m_values[position++]);
+                if (!detail::is_default_value(value.get())) {
+                    kept |= std::uint64_t(1) << bit;
+                    result.m_values.push_back(value);
+                }
+            }
+            result.m_bits[word] = kept;
+        }
+        return result;
+    }
+
+    // Writes all size() entries, defaults included, to destination.
+    primitive<T>* to_dense(primitive<T>* destination) const {
+        std::fill(destination, destination + m_size, primitive<T>());
+        for_each_stored([destination](std::size_t index, primitive<T> const& value) {
+            destination[index] = value;
+        });
+        return destination + m_size;
+    }
+};
+
+template<typename T>
+constexpr std::size_t sparse_primitive_array<T>::word_size;
+
+template<typename T>
+constexpr std::size_t sparse_primitive_array<T>::block_size;
+
+// Sums the products of the stored entries with the matching dense values; defaults contribute nothing.
+template<typename T>
+primitive<T> dot(sparse_primitive_array<T> const& sparse, primitive<T> const* dense) {
+    T total = T();
+    sparse.for_each_stored([&total, dense](std::size_t index, primitive<T> const& value) {
+        total = T(total + value.get() * dense[index].get());
+    });
+    return primitive<T>(total);
+}
+
+// Writes dense + sparse to destination, which may be dense itself.
+template<typename T>
+primitive<T>* add(sparse_primitive_array<T> const& sparse, primitive<T> const* dense, primitive<T>* destination) {
+    if (destination != dense) {
+        std::copy(dense, dense + sparse.size(), destination);
+    }
+    sparse.for_each_stored([destination](std::size_t index, primitive<T> const& value) {
+        destination[index] = primitive<T>(T(destination[index].get() + value.get()));
+    });
+    return destination + sparse.size();
+}
+
+// The element-wise product is the default wherever the sparse array is, so it stays sparse. Unlike a dense
+// floating-point multiply, an infinite or NaN dense value times an absent entry is still zero.
+template<typename T>
+sparse_primitive_array<T> multiply(sparse_primitive_array<T> const& sparse, primitive<T> const* dense) {
+    return sparse.transform_stored([dense](std::size_t index, primitive<T> const& value) {
+        return primitive<T>(T(value.get() * dense[index].get()));
+    });
+}
+
+}  // namespace primitives
+
+#endif
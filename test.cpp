@@ -1,9 +1,24 @@
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <type_traits>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
 #include <utility>
+#include <vector>
 #include "primitive.hpp"
+#include "invariant_divisor.hpp"
+#include "endian_primitive.hpp"
+#include "scan.hpp"
+#include "wide_primitive.hpp"
+#include "half.hpp"
+#include "dynamic_primitive_column.hpp"
+#include "bit.hpp"
+#include "primitive_counter.hpp"
+#include "sparse_primitive_array.hpp"
 
 int main() {
     using std::is_same;
@@ -371,4 +386,412 @@ int main() {
 
     constexpr Char character = 'a';
     static_assert(character.get() == 'a', "Could not read a character.");
-}
\ No newline at end of file
+
+    // Test invariant divisors
+    using primitives::invariant_divisor;
+
+    constexpr invariant_divisor<unsigned int> by_seven(UInt(7u));
+    static_assert((UInt(100u) / by_seven).get() == 14, "Invariant / failed.");
+    static_assert((UInt(100u) % by_seven).get() == 2, "Invariant % failed.");
+
+    constexpr invariant_divisor<int> by_negative_three(Int(-3));
+    static_assert((Int(-100) / by_negative_three).get() == 33, "Invariant signed / failed.");
+    static_assert((Int(-100) % by_negative_three).get() == -1, "Invariant signed % failed.");
+
+    for (int divisor = -300; divisor <= 300; ++divisor) {
+        if (divisor == 0) {
+            continue;
+        }
+        invariant_divisor<int> const invariant{Int(divisor)};
+        for (int numerator = -1000; numerator <= 1000; numerator += 7) {
+            assert((Int(numerator) / invariant).get() == numerator / divisor);
+            assert((Int(numerator) % invariant).get() == numerator % divisor);
+        }
+    }
+
+    invariant_divisor<unsigned long long> const by_large(ULong_Long(0xFFFFFFFFFFFFull));
+    assert((ULong_Long(~0ull) / by_large).get() == ~0ull / 0xFFFFFFFFFFFFull);
+    assert((ULong_Long(~0ull) % by_large).get() == ~0ull % 0xFFFFFFFFFFFFull);
+
+    UInt invariant_quotient(100u);
+    invariant_quotient /= by_seven;
+    assert(invariant_quotient.get() == 14);
+
+    UInt dividends[] = { UInt(0u), UInt(6u), UInt(7u), UInt(50u) };
+    UInt quotients[4];
+    primitives::divide(dividends, dividends + 4, quotients, by_seven);
+    assert(quotients[0] == 0u && quotients[1] == 0u && quotients[2] == 1u && quotients[3] == 7u);
+    UInt remainders[4];
+    primitives::remainder(dividends, dividends + 4, remainders, by_seven);
+    assert(remainders[0] == 0u && remainders[1] == 6u && remainders[2] == 0u && remainders[3] == 1u);
+
+    int const int_min = std::numeric_limits<int>::min();
+    int const int_max = std::numeric_limits<int>::max();
+    Int signed_dividends[29];
+    for (int index = 0; index != 29; ++index) {
+        signed_dividends[index] = Int(index % 2 == 0 ? int_min + index * 1000003 : int_max - index * 999983);
+    }
+    for (int divisor : { 1, -1, 3, -7, 641, -65536, int_max, int_min }) {
+        invariant_divisor<int> const invariant{Int(divisor)};
+        Int batch_quotients[29];
+        Int batch_remainders[29];
+        primitives::divide(signed_dividends, signed_dividends + 29, batch_quotients, invariant);
+        primitives::remainder(signed_dividends, signed_dividends + 29, batch_remainders, invariant);
+        for (int index = 0; index != 29; ++index) {
+            int const numerator = signed_dividends[index].get();
+            if (divisor == -1 && numerator == int_min) {
+                continue;
+            }
+            assert(batch_quotients[index].get() == numerator / divisor);
+            assert(batch_remainders[index].get() == numerator % divisor);
+        }
+    }
+
+    // Test fixed byte order storage
+    using primitives::primitive_le;
+    using primitives::primitive_be;
+
+    static_assert(sizeof(primitive_be<std::uint32_t>) == sizeof(std::uint32_t), "The endian storage has overhead.");
+    static_assert(alignof(primitive_be<std::uint32_t>) == 1, "The endian storage is not byte aligned.");
+
+    assert(primitive_be<int>().get() == 0);
+
+    unsigned char const packet[] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC };
+    auto const big = reinterpret_cast<primitive_be<std::uint32_t> const*>(packet + 1);
+    assert(big->get() == 0x3456789Au);
+    auto const little = reinterpret_cast<primitive_le<std::uint16_t> const*>(packet + 1);
+    assert(little->get() == UShort::from(0x5634u));
+
+    primitive_be<long> promoted = Int(-5);
+    assert(promoted.get() == -5L);
+    primitive_le<double> stored_double = Float(1.5f);
+    assert(stored_double.get() == 1.5);
+
+    primitive_be<std::uint32_t> swapped[9];
+    primitive<std::uint32_t> natives[9];
+    for (int i = 0; i != 9; ++i) {
+        natives[i] = 0x01020304u * std::uint32_t(i + 1);
+    }
+    primitives::store(natives, 9, swapped);
+    assert(reinterpret_cast<unsigned char const*>(swapped)[0] == 0x01);
+    assert(reinterpret_cast<unsigned char const*>(swapped)[3] == 0x04);
+    primitive<std::uint32_t> reloaded[9];
+    primitives::load(swapped, 9, reloaded);
+    for (int i = 0; i != 9; ++i) {
+        assert(swapped[i].get() == natives[i]);
+        assert(reloaded[i] == natives[i]);
+    }
+
+    // Test scans
+    UInt const counts[] = { UInt(3u), UInt(1u), UInt(4u), UInt(1u), UInt(5u), UInt(9u) };
+    UInt offsets[6];
+    primitives::exclusive_scan(counts, counts + 6, offsets, UInt(0u));
+    assert(offsets[0] == 0u && offsets[1] == 3u && offsets[2] == 4u && offsets[5] == 14u);
+    UInt sums[6];
+    primitives::inclusive_scan(counts, counts + 6, sums);
+    assert(sums[0] == 3u && sums[4] == 14u && sums[5] == 23u);
+    UInt running_max[6];
+    primitives::inclusive_scan(counts, counts + 6, running_max, primitives::scan_max());
+    assert(running_max[1] == 3u && running_max[2] == 4u && running_max[5] == 9u);
+    UInt running_min[6];
+    primitives::inclusive_scan(counts, counts + 6, running_min, primitives::scan_min());
+    assert(running_min[0] == 3u && running_min[5] == 1u);
+    UInt running_xor[6];
+    primitives::inclusive_scan(counts, counts + 6, running_xor, primitives::scan_xor());
+    assert(running_xor[2] == (3u ^ 1u ^ 4u));
+
+    UChar const bytes[] = { UChar::from(200u), UChar::from(200u) };
+    UInt widened[2];
+    primitives::inclusive_scan(bytes, bytes + 2, widened);
+    assert(widened[1] == 400u);
+
+    Double const measurements[] = { 0.5, 0.25, 2.0 };
+    Double cumulative[3];
+    primitives::inclusive_scan(measurements, measurements + 3, cumulative);
+    assert(cumulative[2] == 2.75);
+
+    Double const readings[] = { 1.5, -4.0, 8.25, 0.5, -16.0, 2.0, 32.0 };
+    Double running_readings[7];
+    primitives::inclusive_scan(readings, readings + 7, running_readings);
+    assert(running_readings[1] == -2.5 && running_readings[4] == -9.75 && running_readings[6] == 24.25);
+    primitives::exclusive_scan(readings, readings + 7, running_readings, Double(1.0));
+    assert(running_readings[0] == 1.0 && running_readings[3] == 6.75 && running_readings[6] == -6.75);
+    primitives::inclusive_scan(readings, readings + 7, running_readings, primitives::scan_max());
+    assert(running_readings[1] == 1.5 && running_readings[2] == 8.25 && running_readings[5] == 8.25 && running_readings[6] == 32.0);
+    primitives::exclusive_scan(readings, readings + 7, running_readings, Double(-100.0), primitives::scan_min());
+    assert(running_readings[0] == -100.0 && running_readings[6] == -100.0);
+    primitives::inclusive_scan(readings, readings + 7, running_readings, primitives::scan_min());
+    assert(running_readings[0] == 1.5 && running_readings[1] == -4.0 && running_readings[4] == -16.0 && running_readings[6] == -16.0);
+
+    // NaN inputs are skipped by max and min like in a serial loop, but a NaN carry is kept.
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+    Double const gaps[] = { 1.0, nan, 5.0, 2.0, nan, nan, -3.0 };
+    Double running_gaps[7];
+    primitives::inclusive_scan(gaps, gaps + 7, running_gaps, primitives::scan_max());
+    assert(running_gaps[1] == 1.0 && running_gaps[2] == 5.0 && running_gaps[3] == 5.0 && running_gaps[6] == 5.0);
+    primitives::inclusive_scan(gaps + 1, gaps + 7, running_gaps, primitives::scan_min());
+    assert(std::isnan(running_gaps[0].get()) && std::isnan(running_gaps[5].get()));
+    primitives::exclusive_scan(gaps, gaps + 7, running_gaps, Double(4.0), primitives::scan_min());
+    assert(running_gaps[1] == 1.0 && running_gaps[3] == 1.0 && running_gaps[6] == 1.0);
+
+    std::vector<Int> large(std::size_t(1) << 21, Int(1));
+    std::vector<Long_Long> positions(large.size());
+    primitives::exclusive_scan(large.data(), large.data() + large.size(), positions.data(), Long_Long(0LL));
+    for (std::size_t i = 0; i < positions.size(); i += 4099) {
+        assert(positions[i] == static_cast<long long>(i));
+    }
+
+    // Test wide primitives
+    using Int128 = primitives::wide_primitive<128>;
+    using UInt128 = primitives::wide_primitive<128, false>;
+    using Int256 = primitives::wide_primitive<256>;
+
+    static_assert(sizeof(Int128) == 16, "The wide primitive has overhead.");
+    static_assert(Int128() == 0, "The wide primitive was not zeroed out.");
+
+    constexpr Int128 widened_long = Long_Long(-12);
+    static_assert(widened_long == -12, "A signed long long was not promoted to a wide primitive.");
+    constexpr Int256 widened_wide = widened_long;
+    static_assert(widened_wide == -12, "A wide primitive was not promoted to a wider primitive.");
+    static_assert(UInt128::from(-1).limb(1) == ~0ull, "A negative value was not sign extended.");
+
+    constexpr Int128 product = Int128(Long_Long(0x7FFFFFFFFFFFFFFFll)) * 4;
+    static_assert(product.limb(0) == 0xFFFFFFFFFFFFFFFCull && product.limb(1) == 1, "Wide * failed.");
+    static_assert((product + 4).limb(1) == 2 && (product + 4).limb(0) == 0, "Wide + did not carry.");
+    static_assert((product - product - 1) == -1, "Wide - did not borrow.");
+    static_assert(product / 4 == Long_Long(0x7FFFFFFFFFFFFFFFll), "Wide / failed.");
+    static_assert(-product / 3 == -(product / 3), "Wide / did not truncate toward zero.");
+    static_assert(Int128(-7) % 3 == -1, "Wide % failed.");
+    static_assert((Int128(1) << 100) >> 99 == 2, "Wide shifts failed.");
+    static_assert((Int128(-1) >> 70) == -1, "Wide >> did not sign extend.");
+    static_assert((Int128(6) & 3) == 2 && (Int128(6) | 1) == 7 && (Int128(6) ^ 2) == 4, "Wide bitwise operators failed.");
+    static_assert(Int128(-1) < 0 && UInt128(0u) < ~UInt128(0u), "Wide comparisons failed.");
+    static_assert(static_cast<Long_Long>(product).get() == -4, "A wide primitive was not truncated explicitly.");
+    static_assert(static_cast<Double>(Int128(1) << 64).get() == 18446744073709551616.0, "A wide primitive was not converted to a double.");
+    static_assert(static_cast<Double>(-((Int128(2) << 64) + Int128::from(ULong_Long(10595170451058699944ull)))).get() == -4.7488658598477799e19, "A wide primitive was rounded more than once.");
+    static_assert(static_cast<Double>((Int256(1) << 128) + (Int256(1) << 75) + 1).get() == static_cast<Double>((Int256(1) << 128) + (Int256(1) << 76)).get(), "A wide primitive lost the bits below a tie.");
+
+    Int128 counter = 1;
+    counter += Short::from(2);
+    ++counter;
+    counter *= counter;
+    assert(counter == 16);
+
+    std::ostringstream wide_output;
+    wide_output << (Int256(1) << 200) << ' ' << -(Int128(1) << 127) << ' ' << ~UInt128(0u);
+    assert(wide_output.str() == "1606938044258990275541962092341162602522202993782792835301376 "
+        "-170141183460469231731687303715884105728 340282366920938463463374607431768211455");
+
+    Int128 wide_input;
+    std::istringstream wide_stream("-170141183460469231731687303715884105728");
+    wide_stream >> wide_input;
+    assert(wide_input == -(Int128(1) << 127));
+
+    std::istringstream wide_limits("340282366920938463463374607431768211455 340282366920938463463374607431768211456");
+    UInt128 unsigned_input;
+    wide_limits >> unsigned_input;
+    assert(!wide_limits.fail() && unsigned_input == ~UInt128(0u));
+    wide_limits >> unsigned_input;
+    assert(wide_limits.fail() && unsigned_input == ~UInt128(0u));
+    std::istringstream wide_overflow("170141183460469231731687303715884105728");
+    wide_overflow >> wide_input;
+    assert(wide_overflow.fail() && wide_input == ~(Int128(1) << 127));
+    std::istringstream wide_underflow("-1701411834604692317316873037158841057290");
+    wide_underflow >> wide_input;
+    assert(wide_underflow.fail() && wide_input == (Int128(1) << 127));
+
+    // Test half precision storage
+    using primitives::half;
+    using primitives::bfloat16;
+
+    static_assert(sizeof(half) == 2 && sizeof(bfloat16) == 2, "Half precision storage has overhead.");
+    assert(half().get() == 0.0f);
+    assert(bfloat16().get() == 0.0f);
+
+    Float promoted_half = half::from(1.5f);
+    assert(promoted_half == 1.5f);
+    Double promoted_bfloat = bfloat16::from(Float(-2.5f));
+    assert(promoted_bfloat == -2.5);
+
+    assert(half::from(65504.0f).bits() == 0x7BFFu);
+    assert(half::from(65520.0f).bits() == 0x7C00u);
+    assert(half::from(1.0f + 1.0f / 2048.0f).bits() == 0x3C00u);
+    assert(half::from(5.960464477539063e-8f).bits() == 0x0001u);
+    assert(half::from_bits(0x0001u).get() == 5.960464477539063e-8f);
+    assert(bfloat16::from(1.0f + 1.0f / 256.0f).bits() == 0x3F80u);
+    assert(bfloat16::from(1.0f + 3.0f / 256.0f).bits() == 0x3F82u);
+    // Just above a tie as a double, but an exact tie once rounded to float; a double must round only once.
+    double const above_half_tie = 1.0 + 1.0 / 2048.0 + 1.0 / 1099511627776.0;
+    assert(half::from(above_half_tie).bits() == 0x3C01u && half::from(float(above_half_tie)).bits() == 0x3C00u);
+    assert(bfloat16::from(1.0 + 1.0 / 256.0 + 1.0 / 1099511627776.0).bits() == 0x3F81u);
+    assert(half::from(Double(65519.99)).bits() == 0x7BFFu && half::from(1e300).bits() == 0x7C00u);
+    assert(half::from(-1e-300).bits() == 0x8000u && half::from(3.0e-8).bits() == 0x0001u);
+
+    Float const features[] = { 0.0f, 1.0f, -2.0f, 0.5f, 3.25f, -1024.0f, 7.0f, 0.125f, 100.0f, -0.25f };
+    half packed_halves[10];
+    primitives::convert(features, 10, packed_halves);
+    Float unpacked_halves[10];
+    primitives::convert(packed_halves, 10, unpacked_halves);
+    bfloat16 packed_bfloats[10];
+    primitives::convert(features, 10, packed_bfloats);
+    Float unpacked_bfloats[10];
+    primitives::convert(packed_bfloats, 10, unpacked_bfloats);
+    for (int i = 0; i != 10; ++i) {
+        assert(unpacked_halves[i] == features[i]);
+        assert(unpacked_bfloats[i] == features[i]);
+    }
+
+    // Test dynamic primitive columns
+    using primitives::dynamic_primitive_column;
+    using primitives::primitive_kind;
+
+    assert(primitives::promote(primitive_kind::short_, primitive_kind::long_long) == primitive_kind::long_long);
+    assert(primitives::promote(primitive_kind::double_, primitive_kind::float_) == primitive_kind::double_);
+    assert(primitives::promote(primitive_kind::uint, primitive_kind::uint) == primitive_kind::uint);
+    assert(!primitives::can_promote(primitive_kind::int_, primitive_kind::uint));
+    assert(!primitives::can_promote(primitive_kind::double_, primitive_kind::long_long));
+
+    dynamic_primitive_column zeroed_column(primitive_kind::double_, 3);
+    assert(zeroed_column.size() == 3 && zeroed_column.data<double>()[2] == 0.0);
+    assert(reinterpret_cast<std::uintptr_t>(zeroed_column.data<double>()) % dynamic_primitive_column::alignment == 0);
+
+    Int const quantities[] = { 1, 2, 3 };
+    Long_Long const prices[] = { 100LL, 250LL, -40LL };
+    auto const quantity_column = dynamic_primitive_column::from(quantities, 3);
+    auto const price_column = dynamic_primitive_column::from(prices, 3);
+    auto const totals_column = quantity_column * price_column;
+    assert(totals_column.kind() == primitive_kind::long_long);
+    assert(totals_column.data<long long>()[1] == 500LL && totals_column.data<long long>()[2] == -120LL);
+    assert((price_column - quantity_column).data<long long>()[0] == 99LL);
+    assert((price_column / quantity_column).data<long long>()[1] == 125LL);
+    assert((quantity_column + quantity_column).data<int>()[2] == 6);
+    UChar const byte_values[] = { UChar::from(200u), UChar::from(7u) };
+    auto const byte_column = dynamic_primitive_column::from(byte_values, 2);
+    assert((byte_column + byte_column).data<unsigned char>()[0].get() == 144u);
+
+    bool rejected_kind = false;
+    try {
+        quantity_column.data<unsigned int>();
+    } catch (std::invalid_argument const&) {
+        rejected_kind = true;
+    }
+    assert(rejected_kind);
+
+    bool rejected_mix = false;
+    try {
+        quantity_column + dynamic_primitive_column(primitive_kind::uint, 3);
+    } catch (std::invalid_argument const&) {
+        rejected_mix = true;
+    }
+    assert(rejected_mix);
+
+    dynamic_primitive_column moved_from = dynamic_primitive_column::from(prices, 3);
+    dynamic_primitive_column moved_to(std::move(moved_from));
+    {
+        dynamic_primitive_column const released(std::move(moved_to));
+    }
+    dynamic_primitive_column const copied(moved_from);
+    assert(moved_from.size() == 0 && copied.size() == 0 && copied.kind() == primitive_kind::long_long);
+    moved_to = dynamic_primitive_column::from(quantities, 3);
+    assert(moved_to.size() == 3 && moved_to.data<int>()[2] == 3);
+
+    // Test bit manipulation
+    static_assert(primitives::popcount(UInt(0xF0F0u)) == 8, "popcount failed.");
+    static_assert(primitives::popcount(SChar::from(-1)) == 8, "popcount did not count a signed value's bits.");
+    static_assert(primitives::countl_zero(UShort::from(1u)) == 15, "countl_zero failed.");
+    static_assert(primitives::countl_zero(UInt(0u)) == 32 && primitives::countr_zero(ULong_Long(0ull)) == 64, "Counting the zeros of zero failed.");
+    static_assert(primitives::countr_zero(Int(-8)) == 3, "countr_zero failed.");
+    static_assert(primitives::floor_log2(UInt(1000u)) == 9 && primitives::floor_log2(UInt(0u)) == -1, "floor_log2 failed.");
+    static_assert(primitives::rotl(UInt(0x80000001u), 1) == 3u && primitives::rotr(UInt(3u), 1) == 0x80000001u, "Rotation failed.");
+    static_assert(primitives::rotl(UChar::from(0x81u), -1).get() == 0xC0u, "A negative rotation failed.");
+    static_assert(primitives::byteswap(UInt(0x12345678u)) == 0x78563412u, "byteswap failed.");
+    static_assert(primitives::byteswap(Short::from(0x0102)).get() == 0x0201, "byteswap failed for short.");
+    static_assert(primitives::bit_reverse(UInt(1u)) == 0x80000000u && primitives::bit_reverse(UChar::from(0x0Bu)).get() == 0xD0u, "bit_reverse failed.");
+    static_assert(primitives::deposit_bits(UInt(0x5u), UInt(0xF0u)) == 0x50u, "deposit_bits failed.");
+    static_assert(primitives::extract_bits(UInt(0x1234u), UInt(0x0F0Fu)) == 0x24u, "extract_bits failed.");
+
+    ULong_Long const runtime_mask(0x00FF00FF00FF00FFull);
+    assert(primitives::deposit_bits(ULong_Long(0xABCDull), runtime_mask) == 0x00AB00CDull);
+    assert(primitives::extract_bits(ULong_Long(0x1122334455667788ull), runtime_mask) == 0x22446688ull);
+
+    std::vector<UInt> words(1003);
+    std::uint64_t expected_bits = 0;
+    for (std::size_t i = 0; i != words.size(); ++i) {
+        words[i] = UInt(static_cast<unsigned int>(i * 2654435761u));
+        expected_bits += static_cast<std::uint64_t>(primitives::popcount(words[i]).get());
+    }
+    assert(primitives::popcount(words.data(), words.size()) == expected_bits);
+    assert(primitives::popcount(words.data() + 1, 5).get() + primitives::popcount(words[0]).get() == primitives::popcount(words.data(), 6).get());
+
+    // Test sharded counters
+    using primitives::padded_primitive;
+    static_assert(sizeof(padded_primitive<double>) == primitives::cache_line_size, "A padded primitive does not fill one cache line.");
+    static_assert(alignof(padded_primitive<char>) == primitives::cache_line_size, "A padded primitive is not cache line aligned.");
+    padded_primitive<long long> padded_slots[2] = { 3, Int(4) };
+    padded_slots[0].get() += 2;
+    assert(padded_slots[0].get() == 5LL && padded_slots[1].get() == 4LL);
+
+    primitives::primitive_counter<std::uint64_t> requests(5);
+    assert(requests.shard_count() == 8);
+    std::vector<std::thread> incrementers;
+    for (int t = 0; t != 4; ++t) {
+        incrementers.emplace_back([&requests] {
+            for (int i = 0; i != 10000; ++i) {
+                ++requests;
+            }
+            requests += std::uint64_t(5);
+        });
+    }
+    for (auto & incrementer : incrementers) {
+        incrementer.join();
+    }
+    assert(requests.get() == std::uint64_t(40020));
+    requests.reset();
+    assert(requests.get() == std::uint64_t(0));
+
+    primitives::primitive_counter<int> balance;
+    balance.add(3);
+    balance -= 10;
+    --balance;
+    assert(balance.get() == -8);
+
+    // Test sparse arrays
+    using SparseDoubles = primitives::sparse_primitive_array<double>;
+    std::vector<Double> dense_doubles(1500);
+    dense_doubles[3] = 1.5;
+    dense_doubles[600] = -2.0;
+    dense_doubles[1499] = -0.0;
+    auto sparse_doubles = SparseDoubles::from(dense_doubles.data(), dense_doubles.size());
+    assert(sparse_doubles.size() == 1500 && sparse_doubles.stored_count() == 3);
+    assert(sparse_doubles[3] == 1.5 && sparse_doubles[600] == -2.0 && sparse_doubles[4] == 0.0);
+    assert(sparse_doubles.contains(1499) && !sparse_doubles.contains(0));
+
+    sparse_doubles.set(1000, 4.0);
+    sparse_doubles.set(3, 0.0);
+    sparse_doubles.set(600, 3.0);
+    assert(sparse_doubles.stored_count() == 3 && sparse_doubles[1000] == 4.0 && sparse_doubles[600] == 3.0 && !sparse_doubles.contains(3));
+
+    std::vector<std::size_t> stored_indices;
+    sparse_doubles.for_each_stored([&stored_indices](std::size_t index, Double const&) { stored_indices.push_back(index); });
+    assert((stored_indices == std::vector<std::size_t>{ 600, 1000, 1499 }));
+
+    std::vector<Double> round_trip(1500, Double(7.0));
+    assert(sparse_doubles.to_dense(round_trip.data()) == round_trip.data() + 1500);
+    assert(round_trip[0] == 0.0 && round_trip[1000] == 4.0 && std::signbit(round_trip[1499].get()));
+
+    std::vector<Double> weights(1500, Double(2.0));
+    weights[1000] = 0.0;
+    assert(primitives::dot(sparse_doubles, weights.data()) == 6.0);
+    primitives::add(sparse_doubles, weights.data(), weights.data());
+    assert(weights[600] == 5.0 && weights[601] == 2.0);
+    auto const products = primitives::multiply(sparse_doubles, round_trip.data());
+    assert(products.stored_count() == 2 && products[1000] == 16.0 && products[600] == 9.0 && !products.contains(1499));
+
+    primitives::sparse_primitive_array<int> sparse_ints(100);
+    for (int i = 99; i >= 0; i -= 3) {
+        sparse_ints.set(std::size_t(i), i);
+    }
+    assert(sparse_ints.stored_count() == 33 && sparse_ints[99] == 99 && sparse_ints[98] == 0 && sparse_ints[0] == 0);
+    auto const zeroed = primitives::multiply(sparse_ints, std::vector<Int>(100, Int(0)).data());
+    assert(zeroed.stored_count() == 0);
+}
@@ -0,0 +1,585 @@
+#ifndef WIDE_PRIMITIVE_HPP
+#define WIDE_PRIMITIVE_HPP
+
+#include "primitive.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace primitives {
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+// __extension__ keeps -Wpedantic from flagging the compiler's 128-bit integers.
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+// Returns the low 64 bits of the product and stores the high 64 bits in high.
+constexpr std::uint64_t multiply_full(std::uint64_t lhs, std::uint64_t rhs, std::uint64_t& high) noexcept {
+#if defined(__SIZEOF_INT128__)
+    uint128 const product = static_cast<uint128>(lhs) * rhs;
+    high = std::uint64_t(product >> 64);
+    return std::uint64_t(product);
+#else
+    std::uint64_t const lhs_lo = lhs & 0xFFFFFFFFu, lhs_hi = lhs >> 32;
+    std::uint64_t const rhs_lo = rhs & 0xFFFFFFFFu, rhs_hi = rhs >> 32;
+    std::uint64_t const lo_lo = lhs_lo * rhs_lo;
+    std::uint64_t const hi_lo = lhs_hi * rhs_lo;
+    std::uint64_t const lo_hi = lhs_lo * rhs_hi;
+    std::uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    high = lhs_hi * rhs_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+#endif
+}
+
+// Returns the low 64 bits of lhs * rhs + addend + carry and stores the high 64 bits in carry; the sum cannot overflow.
+constexpr std::uint64_t multiply_add(std::uint64_t lhs, std::uint64_t rhs, std::uint64_t addend, std::uint64_t& carry) noexcept {
+#if defined(__SIZEOF_INT128__)
+    uint128 const sum = static_cast<uint128>(lhs) * rhs + addend + carry;
+    carry = std::uint64_t(sum >> 64);
+    return std::uint64_t(sum);
+#else
+    std::uint64_t high = 0;
+    std::uint64_t low = multiply_full(lhs, rhs, high);
+    low += addend;
+    high += low < addend ? 1u : 0u;
+    low += carry;
+    high += low < carry ? 1u : 0u;
+    carry = high;
+    return low;
+#endif
+}
+
+// Adds with an incoming carry and sets carry to the outgoing carry; compilers lower this to add-with-carry.
+constexpr std::uint64_t add_carry(std::uint64_t lhs, std::uint64_t rhs, bool& carry) noexcept {
+    std::uint64_t const partial = lhs + rhs;
+    std::uint64_t const sum = partial + (carry ? 1u : 0u);
+    carry = partial < lhs || sum < partial;
+    return sum;
+}
+
+// Subtracts with an incoming borrow and sets borrow to the outgoing borrow; compilers lower this to subtract-with-borrow.
+constexpr std::uint64_t subtract_borrow(std::uint64_t lhs, std::uint64_t rhs, bool& borrow) noexcept {
+    std::uint64_t const partial = lhs - rhs;
+    std::uint64_t const difference = partial - (borrow ? 1u : 0u);
+    borrow = lhs < rhs || partial < difference;
+    return difference;
+}
+
+template<typename U>
+constexpr bool is_wide_source() noexcept {
+    return std::is_integral<U>::value
+        && !std::is_same<U, bool>::value
+        && !std::is_same<U, char>::value
+        && !std::is_same<U, wchar_t>::value
+        && !std::is_same<U, char16_t>::value
+        && !std::is_same<U, char32_t>::value;
+}
+
+}  // namespace detail
+
+// A fixed-width two's complement integer of Bits bits, stored as 64-bit limbs with the least significant limb first.
+template<std::size_t Bits, bool Signed = true>
+class wide_primitive final {
+    static_assert(Bits >= 128 && Bits % 64 == 0, "Wide primitives are a multiple of 64 bits, at least 128.");
+
+    template<std::size_t, bool> friend class wide_primitive;
+
+    static constexpr std::size_t limb_count = Bits / 64;
+
+    std::uint64_t m_limbs[limb_count];
+
+    template<typename U>
+    constexpr void assign_integral(U const& value) noexcept {
+        m_limbs[0] = std::uint64_t(value);
+        std::uint64_t const fill = std::is_signed<U>::value && value < U() ? ~std::uint64_t() : std::uint64_t();
+        for (std::size_t index = 1; index != limb_count; ++index) {
+            m_limbs[index] = fill;
+        }
+    }
+
+    template<std::size_t OtherBits, bool OtherSigned>
+    constexpr void assign_wide(wide_primitive<OtherBits, OtherSigned> const& other) noexcept {
+        constexpr std::size_t other_count = OtherBits / 64;
+        std::uint64_t const fill = other.is_negative() ? ~std::uint64_t() : std::uint64_t();
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            m_limbs[index] = index < other_count ? other.m_limbs[index] : fill;
+        }
+    }
+
+    // Integers keep the low bits, like a static_cast between built-in integers.
+    template<typename U>
+    constexpr U convert(std::true_type) const noexcept {
+        return static_cast<U>(m_limbs[0]);
+    }
+
+    // Floating point rounds once, like a built-in conversion: the 64 bits from the leading one (128 for significands
+    // of 64 bits or more) are converted with a sticky bit standing in for everything below, then scaled exactly.
+    template<typename U>
+    constexpr U convert(std::false_type) const noexcept {
+        wide_primitive const absolute = magnitude();
+        std::size_t const count = absolute.significant_limbs();
+        if (count == 0) {
+            return U();
+        }
+        int shift = 0;
+        while ((absolute.m_limbs[count - 1] << shift >> 63) == 0) {
+            ++shift;
+        }
+        wide_primitive const normalized = shift_left(absolute, std::size_t(shift));
+        std::uint64_t const high = normalized.m_limbs[count - 1];
+        std::uint64_t const low = count >= 2 ? normalized.m_limbs[count - 2] : 0;
+        bool sticky = false;
+        for (std::size_t index = 0; index + 2 < count; ++index) {
+            sticky = sticky || normalized.m_limbs[index] != 0;
+        }
+        int const exponent = int(64 * (count - 1)) - shift;
+        U const result = std::numeric_limits<U>::digits < 64
+            ? scale(U(high | (low != 0 || sticky ? 1u : 0u)), exponent)
+            : scale(U(high) * U(18446744073709551616.0) + U(low | (sticky ? 1u : 0u)), exponent - 64);
+        return is_negative() ? -result : result;
+    }
+
+    // Multiplies by 2^exponent, which is exact until the result overflows.
+    template<typename U>
+    static constexpr U scale(U value, int exponent) noexcept {
+        for (; exponent >= 64; exponent -= 64) {
+            value *= U(18446744073709551616.0);
+        }
+        for (; exponent <= -64; exponent += 64) {
+            value /= U(18446744073709551616.0);
+        }
+        return exponent >= 0 ? value * U(std::uint64_t(1) << exponent) : value / U(std::uint64_t(1) << -exponent);
+    }
+
+    constexpr bool is_negative() const noexcept {
+        return Signed && (m_limbs[limb_count - 1] >> 63) != 0;
+    }
+
+    constexpr bool is_zero() const noexcept {
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            if (m_limbs[index] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr std::size_t significant_limbs() const noexcept {
+        std::size_t count = limb_count;
+        while (count != 0 && m_limbs[count - 1] == 0) {
+            --count;
+        }
+        return count;
+    }
+
+    constexpr wide_primitive magnitude() const noexcept {
+        return is_negative() ? -*this : *this;
+    }
+
+    constexpr int compare_unsigned(wide_primitive const& other) const noexcept {
+        for (std::size_t index = limb_count; index != 0; --index) {
+            if (m_limbs[index - 1] != other.m_limbs[index - 1]) {
+                return m_limbs[index - 1] < other.m_limbs[index - 1] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    constexpr int compare(wide_primitive const& other) const noexcept {
+        if (is_negative() != other.is_negative()) {
+            return is_negative() ? -1 : 1;
+        }
+        return compare_unsigned(other);
+    }
+
+    // Divides this magnitude by a single limb, returning the remainder.
+    constexpr std::uint64_t divide_limb(std::uint64_t divisor) noexcept {
+        std::uint64_t remainder = 0;
+        for (std::size_t index = limb_count; index != 0; --index) {
+#if defined(__SIZEOF_INT128__)
+            detail::uint128 const dividend = (static_cast<detail::uint128>(remainder) << 64) | m_limbs[index - 1];
+            m_limbs[index - 1] = std::uint64_t(dividend / divisor);
+            remainder = std::uint64_t(dividend % divisor);
+#else
+            std::uint64_t quotient = 0;
+            for (int bit = 63; bit >= 0; --bit) {
+                bool const carry = (remainder >> 63) != 0;
+                remainder = (remainder << 1) | ((m_limbs[index - 1] >> bit) & 1u);
+                if (carry || remainder >= divisor) {
+                    remainder -= divisor;
+                    quotient |= std::uint64_t(1) << bit;
+                }
+            }
+            m_limbs[index - 1] = quotient;
+#endif
+        }
+        return remainder;
+    }
+
+    // Unsigned long division: quotient replaces dividend, remainder is returned.
+    static constexpr wide_primitive divide_unsigned(wide_primitive& dividend, wide_primitive const& divisor) noexcept {
+        if (divisor.significant_limbs() <= 1) {
+            wide_primitive remainder;
+            remainder.m_limbs[0] = dividend.divide_limb(divisor.m_limbs[0]);
+            return remainder;
+        }
+        wide_primitive remainder;
+        wide_primitive quotient;
+        for (std::size_t bit = dividend.significant_limbs() * 64; bit != 0; --bit) {
+            remainder = shift_left(remainder, 1);
+            remainder.m_limbs[0] |= (dividend.m_limbs[(bit - 1) / 64] >> ((bit - 1) % 64)) & 1u;
+            if (remainder.compare_unsigned(divisor) >= 0) {
+                remainder -= divisor;
+                quotient.m_limbs[(bit - 1) / 64] |= std::uint64_t(1) << ((bit - 1) % 64);
+            }
+        }
+        dividend = quotient;
+        return remainder;
+    }
+
+    static constexpr wide_primitive shift_left(wide_primitive const& value, std::size_t shift) noexcept {
+        wide_primitive result;
+        if (shift >= Bits) {
+            return result;
+        }
+        std::size_t const limbs = shift / 64;
+        std::size_t const bits = shift % 64;
+        for (std::size_t index = limb_count; index-- != limbs;) {
+            std::uint64_t limb = value.m_limbs[index - limbs] << bits;
+            if (bits != 0 && index != limbs) {
+                limb |= value.m_limbs[index - limbs - 1] >> (64 - bits);
+            }
+            result.m_limbs[index] = limb;
+        }
+        return result;
+    }
+
+    static constexpr wide_primitive shift_right(wide_primitive const& value, std::size_t shift) noexcept {
+        std::uint64_t const fill = value.is_negative() ? ~std::uint64_t() : std::uint64_t();
+        wide_primitive result;
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            result.m_limbs[index] = fill;
+        }
+        if (shift >= Bits) {
+            return result;
+        }
+        std::size_t const limbs = shift / 64;
+        std::size_t const bits = shift % 64;
+        for (std::size_t index = 0; index + limbs != limb_count; ++index) {
+            std::uint64_t limb = value.m_limbs[index + limbs] >> bits;
+            if (bits != 0) {
+                std::uint64_t const next = index + limbs + 1 != limb_count ? value.m_limbs[index + limbs + 1] : fill;
+                limb |= next << (64 - bits);
+            }
+            result.m_limbs[index] = limb;
+        }
+        return result;
+    }
+
+public:
+    static constexpr std::size_t bits = Bits;
+    static constexpr bool is_signed = Signed;
+
+    constexpr wide_primitive() noexcept : m_limbs() {}
+
+    template<typename U, typename = std::enable_if_t<
+        detail::is_wide_source<U>() && std::is_signed<U>::value == Signed
+    >>
+    constexpr wide_primitive(U const& value) noexcept : m_limbs() {
+        assign_integral(value);
+    }
+
+    template<typename U, typename = std::enable_if_t<
+        detail::is_wide_source<U>() && std::is_signed<U>::value == Signed
+    >>
+    constexpr wide_primitive(primitive<U> const& other) noexcept : m_limbs() {
+        assign_integral(other.get());
+    }
+
+    template<std::size_t OtherBits, typename = std::enable_if_t< (OtherBits < Bits) >>
+    constexpr wide_primitive(wide_primitive<OtherBits, Signed> const& other) noexcept : m_limbs() {
+        assign_wide(other);
+    }
+
+    template<typename U, typename = std::enable_if_t< detail::is_wide_source<U>() >>
+    constexpr static wide_primitive from(U const& other) noexcept {
+        wide_primitive result;
+        result.assign_integral(other);
+        return result;
+    }
+
+    template<typename U, typename = std::enable_if_t< detail::is_wide_source<U>() >>
+    constexpr static wide_primitive from(primitive<U> const& other) noexcept {
+        return from(other.get());
+    }
+
+    template<std::size_t OtherBits, bool OtherSigned>
+    constexpr static wide_primitive from(wide_primitive<OtherBits, OtherSigned> const& other) noexcept {
+        wide_primitive result;
+        result.assign_wide(other);
+        return result;
+    }
+
+    wide_primitive(wide_primitive const&) = default;
+    wide_primitive(wide_primitive &&) = default;
+
+    wide_primitive& operator=(wide_primitive const&) = default;
+    wide_primitive& operator=(wide_primitive &&) = default;
+
+    // Returns the 64-bit limb at index, least significant first.
+    constexpr std::uint64_t limb(std::size_t index) const noexcept { return m_limbs[index]; }
+
+    template<typename U, typename = std::enable_if_t< std::is_arithmetic<U>::value >>
+    constexpr explicit operator primitive<U>() const noexcept {
+        return primitive<U>(convert<U>(std::is_integral<U>()));
+    }
+
+    constexpr wide_primitive const& operator+() const noexcept {
+        return *this;
+    }
+    constexpr wide_primitive operator-() const noexcept {
+        return wide_primitive() - *this;
+    }
+    constexpr wide_primitive operator~() const noexcept {
+        wide_primitive result;
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            result.m_limbs[index] = ~m_limbs[index];
+        }
+        return result;
+    }
+
+    constexpr wide_primitive& operator++() noexcept {
+        return *this += wide_primitive::from(1);
+    }
+    constexpr wide_primitive operator++(int) noexcept {
+        wide_primitive const previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    constexpr wide_primitive& operator--() noexcept {
+        return *this -= wide_primitive::from(1);
+    }
+    constexpr wide_primitive operator--(int) noexcept {
+        wide_primitive const previous = *this;
+        --*this;
+        return previous;
+    }
+
+    constexpr wide_primitive& operator+=(wide_primitive const& other) noexcept {
+        bool carry = false;
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            m_limbs[index] = detail::add_carry(m_limbs[index], other.m_limbs[index], carry);
+        }
+        return *this;
+    }
+
+    constexpr wide_primitive& operator-=(wide_primitive const& other) noexcept {
+        bool borrow = false;
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            m_limbs[index] = detail::subtract_borrow(m_limbs[index], other.m_limbs[index], borrow);
+        }
+        return *this;
+    }
+
+    // Schoolbook multiplication truncated to Bits; two's complement makes it correct for signed values too.
+    constexpr wide_primitive& operator*=(wide_primitive const& other) noexcept {
+        wide_primitive result;
+        for (std::size_t i = 0; i != limb_count; ++i) {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; i + j + 1 != limb_count; ++j) {
+                result.m_limbs[i + j] = detail::multiply_add(m_limbs[i], other.m_limbs[j], result.m_limbs[i + j], carry);
+            }
+            // Only the low half of the top product survives truncation.
+            result.m_limbs[limb_count - 1] += m_limbs[i] * other.m_limbs[limb_count - 1 - i] + carry;
+        }
+        return *this = result;
+    }
+
+    // Truncates toward zero, like the built-in operator; the divisor must not be zero.
+    constexpr wide_primitive& operator/=(wide_primitive const& other) noexcept {
+        bool const negative = is_negative() != other.is_negative();
+        wide_primitive quotient = magnitude();
+        divide_unsigned(quotient, other.magnitude());
+        return *this = negative ? -quotient : quotient;
+    }
+
+    // Takes the sign of the dividend, like the built-in operator; the divisor must not be zero.
+    constexpr wide_primitive& operator%=(wide_primitive const& other) noexcept {
+        bool const negative = is_negative();
+        wide_primitive quotient = magnitude();
+        wide_primitive const remainder = divide_unsigned(quotient, other.magnitude());
+        return *this = negative ? -remainder : remainder;
+    }
+
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    constexpr wide_primitive& operator<<=(U const& shift) noexcept {
+        return *this = shift_left(*this, std::size_t(shift));
+    }
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    constexpr wide_primitive& operator<<=(primitive<U> const& shift) noexcept {
+        return *this = shift_left(*this, std::size_t(shift.get()));
+    }
+
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    constexpr wide_primitive& operator>>=(U const& shift) noexcept {
+        return *this = shift_right(*this, std::size_t(shift));
+    }
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    constexpr wide_primitive& operator>>=(primitive<U> const& shift) noexcept {
+        return *this = shift_right(*this, std::size_t(shift.get()));
+    }
+
+    constexpr wide_primitive& operator&=(wide_primitive const& other) noexcept {
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            m_limbs[index] &= other.m_limbs[index];
+        }
+        return *this;
+    }
+
+    constexpr wide_primitive& operator|=(wide_primitive const& other) noexcept {
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            m_limbs[index] |= other.m_limbs[index];
+        }
+        return *this;
+    }
+
+    constexpr wide_primitive& operator^=(wide_primitive const& other) noexcept {
+        for (std::size_t index = 0; index != limb_count; ++index) {
+            m_limbs[index] ^= other.m_limbs[index];
+        }
+        return *this;
+    }
+
+    // The binary operators are hidden friends so integers, primitives and narrower wide primitives promote implicitly.
+    friend constexpr wide_primitive operator+(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs += rhs;
+    }
+    friend constexpr wide_primitive operator-(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs -= rhs;
+    }
+    friend constexpr wide_primitive operator*(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs *= rhs;
+    }
+    friend constexpr wide_primitive operator/(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs /= rhs;
+    }
+    friend constexpr wide_primitive operator%(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs %= rhs;
+    }
+    friend constexpr wide_primitive operator&(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs &= rhs;
+    }
+    friend constexpr wide_primitive operator|(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs |= rhs;
+    }
+    friend constexpr wide_primitive operator^(wide_primitive lhs, wide_primitive const& rhs) noexcept {
+        return lhs ^= rhs;
+    }
+
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    friend constexpr wide_primitive operator<<(wide_primitive const& lhs, U const& rhs) noexcept {
+        return shift_left(lhs, std::size_t(rhs));
+    }
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    friend constexpr wide_primitive operator<<(wide_primitive const& lhs, primitive<U> const& rhs) noexcept {
+        return shift_left(lhs, std::size_t(rhs.get()));
+    }
+
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    friend constexpr wide_primitive operator>>(wide_primitive const& lhs, U const& rhs) noexcept {
+        return shift_right(lhs, std::size_t(rhs));
+    }
+    template<typename U, typename = std::enable_if_t< std::is_integral<U>::value >>
+    friend constexpr wide_primitive operator>>(wide_primitive const& lhs, primitive<U> const& rhs) noexcept {
+        return shift_right(lhs, std::size_t(rhs.get()));
+    }
+
+    friend constexpr bool operator==(wide_primitive const& lhs, wide_primitive const& rhs) noexcept {
+        return lhs.compare_unsigned(rhs) == 0;
+    }
+    friend constexpr bool operator!=(wide_primitive const& lhs, wide_primitive const& rhs) noexcept {
+        return lhs.compare_unsigned(rhs) != 0;
+    }
+    friend constexpr bool operator<(wide_primitive const& lhs, wide_primitive const& rhs) noexcept {
+        return lhs.compare(rhs) < 0;
+    }
+    friend constexpr bool operator<=(wide_primitive const& lhs, wide_primitive const& rhs) noexcept {
+        return lhs.compare(rhs) <= 0;
+    }
+    friend constexpr bool operator>(wide_primitive const& lhs, wide_primitive const& rhs) noexcept {
+        return lhs.compare(rhs) > 0;
+    }
+    friend constexpr bool operator>=(wide_primitive const& lhs, wide_primitive const& rhs) noexcept {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& lhs, wide_primitive const& rhs) {
+        // Peel off 19 decimal digits at a time, the most that fit in one limb, least significant first.
+        wide_primitive remaining = rhs.magnitude();
+        std::string digits;
+        do {
+            std::uint64_t part = remaining.divide_limb(10000000000000000000ull);
+            for (int count = 0; count != 19; ++count) {
+                digits.push_back(char('0' + part % 10));
+                part /= 10;
+            }
+        } while (!remaining.is_zero());
+        while (digits.size() > 1 && digits.back() == '0') {
+            digits.pop_back();
+        }
+        if (rhs.is_negative()) {
+            digits.push_back('-');
+        }
+        std::reverse(digits.begin(), digits.end());
+        return lhs << digits;
+    }
+
+    friend std::istream& operator>>(std::istream& lhs, wide_primitive& rhs) {
+        std::string token;
+        if (!(lhs >> token)) {
+            return lhs;
+        }
+        std::size_t index = token[0] == '-' || token[0] == '+' ? 1 : 0;
+        bool const negative = token[0] == '-';
+        if (index == token.size() || (negative && !Signed)) {
+            lhs.setstate(std::ios_base::failbit);
+            return lhs;
+        }
+        // The magnitude is accumulated unsigned and checked against the largest one the type can hold, which is
+        // one more for negative values. Like built-in extraction, overflow stores the nearest limit and fails.
+        using magnitude_type = wide_primitive<Bits, false>;
+        magnitude_type const ten = magnitude_type::from(10);
+        magnitude_type const limit = Signed
+            ? (magnitude_type::from(1) << (Bits - 1)) - magnitude_type::from(negative ? 0 : 1)
+            : ~magnitude_type();
+        magnitude_type const limit_tenth = limit / ten;
+        magnitude_type const limit_digit = limit % ten;
+        magnitude_type result;
+        for (; index != token.size(); ++index) {
+            if (token[index] < '0' || token[index] > '9') {
+                lhs.setstate(std::ios_base::failbit);
+                return lhs;
+            }
+            magnitude_type const digit = magnitude_type::from(token[index] - '0');
+            if (result > limit_tenth || (result == limit_tenth && digit > limit_digit)) {
+                result = limit;
+                lhs.setstate(std::ios_base::failbit);
+                break;
+            }
+            result = result * ten + digit;
+        }
+        rhs = negative ? -wide_primitive::from(result) : wide_primitive::from(result);
+        return lhs;
+    }
+};
+
+}  // namespace primitives
+
+#endif